@@ -58,6 +58,14 @@ extern void Assignable_writeBarrier(CPointer, Objptr, Objptr*, Objptr);
 extern Objptr Assignable_readBarrier(CPointer, Objptr, Objptr*);
 extern Objptr Assignable_decheckObjptr(Objptr, Objptr);
 
+/* ------------------------------------------------- */
+/*                 Sporks                            */
+/* ------------------------------------------------- */
+
+extern void GC_sporkEnter(CPointer, CPointer);
+extern void GC_spoinExit(CPointer, CPointer);
+extern void GC_sporkUnwind(CPointer, CPointer);
+
 static inline
 Real64 ArrayR64_cas(Real64* a, Word64 i, Real64 x, Real64 y) {
   Word64 result =
@@ -77,9 +77,7 @@ void MLton_threadFunc (void* arg) {                                     \
                                                                         \
   /* Do not set CPU affinity when running on a single processor  */     \
   if (s->controls->setAffinity && s->numberOfProcs > 1) {               \
-      uint32_t num = Proc_processorNumber (s)                           \
-          * s->controls->affinityStride                                 \
-          + s->controls->affinityBase;                                  \
+      uint32_t num = Proc_cpuOfProcessor (s, Proc_processorNumber (s)); \
       set_cpu_affinity(num);                                            \
   }                                                                     \
                                                                         \
@@ -93,23 +91,12 @@ void MLton_threadFunc (void* arg) {                                     \
     /* Return to the saved world */                                     \
     nextBlock = getNextBlockFromStackTop (s);                           \
   }                                                                     \
-  /* Check to see whether or not we are the last thread; this assigns   \
-   * the "main" computation to the last thread, so that we can use the  \
-   * first thread as the signal relayer if necessary.                   \
-   */                                                                   \
+  /* The first thread runs the "main" computation. */                   \
   if (Proc_processorNumber (s) == 0) {                                  \
     Trace0(EVENT_LAUNCH);                                               \
     /* Trampoline */                                                    \
     MLton_trampoline (s, nextBlock, FALSE);                             \
   }                                                                     \
-  else if (s->numberOfProcs > s->controls->heartbeatRelayerThreshold    \
-           && s->numberOfProcs >= 2                                     \
-           && Proc_processorNumber(s) == s->numberOfProcs-1)            \
-  {                                                                     \
-    Proc_waitForInitialization(s);                                      \
-    HH_EBR_enterQuiescentState(s);                                      \
-    relayerLoop(s);                                                     \
-  }                                                                     \
   else {                                                                \
     Proc_waitForInitialization (s);                                     \
     Trace0(EVENT_LAUNCH);                                               \
@@ -160,6 +147,9 @@ void MLton_threadFunc (void* arg) {                                     \
         exit (1);                                                       \
       }                                                                 \
     }                                                                   \
+    /* With many processors, heartbeats come from a separate relayer */ \
+    if (heartbeatRelayerNeeded (&gcState[0]))                           \
+      startHeartbeatRelayer (&gcState[0]);                              \
     MLton_threadFunc ((void *)&gcState[0]);                             \
   }
 
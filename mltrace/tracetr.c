@@ -83,6 +83,8 @@ static const char *EventKindStrings[] = {
 
   [EVENT_SCHED_SLEEP_ENTER] = "SCHED_SLEEP_ENTER",
   [EVENT_SCHED_SLEEP_LEAVE] = "SCHED_SLEEP_LEAVE",
+
+  [EVENT_TRACE_DROPPED] = "TRACE_DROPPED",
 };
 
 void processFiles(size_t filecount, FILE **files, void (*func)(struct Event *));
@@ -436,6 +438,10 @@ void printEventText(struct Event *event) {
            event->arg1, event->arg2, event->arg3);
     break;
 
+  case EVENT_TRACE_DROPPED:
+    printf("dropped = %lld", event->arg1);
+    break;
+
   default:
     printf("?1 = %llx, ?2 = %llx, ?3 = %llx",
            event->arg1, event->arg2, event->arg3);
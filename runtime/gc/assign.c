@@ -41,11 +41,18 @@ objptr Assignable_readBarrier(
 {
 // can't rely on obj header becaues it may be forwarded.
 
-  s->cumulativeStatistics->numDisentanglementChecks++;
+  /* The compiler only calls this when obj has its suspect bit set (see
+   * suspicious_header), so this is the slow path. Do the cheap checks before
+   * chasing the level head. */
   objptr ptr = __atomic_load_n(field, __ATOMIC_ACQUIRE);
+  if (!isObjptr(ptr)) {
+    return ptr;
+  }
+
+  s->cumulativeStatistics->numDisentanglementChecks++;
   pointer objp = objptrToPointer(obj, NULL);
   HM_HierarchicalHeap objHH = HM_getLevelHead(HM_getChunkOf(objp));
-  if (!isObjptr(ptr) || HM_HH_getDepth(objHH) == 0 || !ES_contains(NULL, obj))
+  if (HM_HH_getDepth(objHH) == 0 || !ES_contains(NULL, obj))
   {
     return ptr;
   }
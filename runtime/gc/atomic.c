@@ -29,6 +29,7 @@ void endAtomic (GC_state s) {
   assert(s->atomicState >= 1);
   s->atomicState--;
   if (0 == s->atomicState
-      and s->signalsInfo.signalIsPending)
+      and (s->signalsInfo.signalIsPending
+           or atomicLoadU32(&(s->heartbeatPollPending))))
     s->limit = 0;
 }
@@ -133,8 +133,21 @@ static void initBlockAllocator(GC_state s, BlockAllocator ball) {
   }
 
   ball->completelyEmptyGroup.firstSuperBlock = NULL;
+  ball->numEmptySuperBlocks = 0;
+
+  ball->decommitPass = 0;
+  timespec_now(&(ball->nextDecommitPass));
+  timespec_add(&(ball->nextDecommitPass), &(s->controls->decommitDelay));
+  ball->numBlocksDecommitted = 0;
+  ball->recentBytesInUse = 0;
 
   ball->firstFreedByOther = NULL;
+  for (int i = 0; i < NUM_REMOTE_FREE_BATCHES; i++) {
+    ball->remoteFreeBatches[i].owner = NULL;
+    ball->remoteFreeBatches[i].first = NULL;
+    ball->remoteFreeBatches[i].last = NULL;
+    ball->remoteFreeBatches[i].count = 0;
+  }
   ball->numBlocksMapped = 0;
   ball->numBlocksReleased = 0;
   for (enum BlockPurpose p = 0; p < NUM_BLOCK_PURPOSES; p++) {
@@ -146,13 +159,36 @@ static void initBlockAllocator(GC_state s, BlockAllocator ball) {
     ball->megaBlockSizeClass[i].firstMegaBlock = NULL;
   }
   pthread_mutex_init(&(ball->megaBlockLock), NULL);
+  ball->numCachedMegaBlockBlocks = 0;
+  ball->numMegaBlockLockContended = 0;
+
+  ball->numaNode = 0;
+  ball->nodePool = NULL;
+  ball->nodePools = NULL;
+  ball->numNodePools = 0;
+  pthread_mutex_init(&(ball->superBlockLock), NULL);
 }
 
 
 BlockAllocator initGlobalBlockAllocator(GC_state s) {
   s->blockAllocatorGlobal = malloc(sizeof(struct BlockAllocator));
-  initBlockAllocator(s, s->blockAllocatorGlobal);
-  return s->blockAllocatorGlobal;
+  BlockAllocator global = s->blockAllocatorGlobal;
+  initBlockAllocator(s, global);
+
+  if (s->controls->numaAware) {
+    global->numNodePools = GC_numaNumNodes();
+    global->nodePools =
+      malloc(global->numNodePools * sizeof(struct BlockAllocator));
+    for (uint32_t node = 0; node < global->numNodePools; node++) {
+      initBlockAllocator(s, &(global->nodePools[node]));
+      global->nodePools[node].numaNode = node;
+    }
+    LOG(LM_BLOCK_ALLOCATOR, LL_INFO,
+      "NUMA-aware block allocation with %"PRIu32" nodes",
+      global->numNodePools);
+  }
+
+  return global;
 }
 
 
@@ -164,6 +200,62 @@ void initLocalBlockAllocator(GC_state s, BlockAllocator globalBall) {
 }
 
 
+/** The pool of the node that this processor runs on. This is determined
+  * lazily, because the processor number is not yet known when the local
+  * allocator is initialized. Processors are pinned in NUMA-aware mode, so
+  * the answer never changes.
+  */
+static BlockAllocator getNodePool(GC_state s) {
+  assert(s->controls->numaAware);
+  BlockAllocator local = s->blockAllocatorLocal;
+
+  if (NULL == local->nodePool) {
+    BlockAllocator global = s->blockAllocatorGlobal;
+    uint32_t cpu = Proc_cpuOfProcessor(s, s->procNumber);
+    uint32_t node = GC_numaNodeOfCPU(cpu);
+    if (node >= global->numNodePools)
+      node = 0;
+    local->numaNode = node;
+    local->nodePool = &(global->nodePools[node]);
+    LOG(LM_BLOCK_ALLOCATOR, LL_INFO,
+      "processor %"PRIu32" (cpu %"PRIu32") is on node %"PRIu32,
+      s->procNumber,
+      cpu,
+      node);
+  }
+
+  return local->nodePool;
+}
+
+
+/** Where megablocks are kept: the global allocator, or in NUMA-aware mode,
+  * the pool of the given node.
+  */
+static inline BlockAllocator getMegaBlockPool(GC_state s, uint32_t node) {
+  BlockAllocator global = s->blockAllocatorGlobal;
+  if (!s->controls->numaAware)
+    return global;
+  assert(node < global->numNodePools);
+  return &(global->nodePools[node]);
+}
+
+
+/** Take the megaBlockLock of a shared pool, counting contention. */
+static inline void lockMegaBlockPool(BlockAllocator pool) {
+  if (0 != pthread_mutex_trylock(&(pool->megaBlockLock))) {
+    __sync_fetch_and_add(&(pool->numMegaBlockLockContended), 1);
+    pthread_mutex_lock(&(pool->megaBlockLock));
+  }
+}
+
+
+/** Number of superblocks that mmapNewSuperBlocks maps at a time. */
+static inline size_t superBlocksPerMap(GC_state s) {
+  size_t oneWidth = s->controls->blockSize * (1 + SUPERBLOCK_SIZE(s));
+  return 1 + (s->controls->allocBlocksMinSize-1) / oneWidth;
+}
+
+
 static int computeSizeClass(size_t numBlocks) {
   int class = 0;
   while (((size_t)1 << class) < numBlocks) {
@@ -173,6 +265,115 @@ static int computeSizeClass(size_t numBlocks) {
 }
 
 
+/** With huge pages, requests of at least one huge page are rounded up to a
+  * whole number of huge pages before computing their size class. Otherwise
+  * the tail of such an allocation would share a huge page with nothing
+  * else, and touching any of it would commit the whole huge page anyway.
+  * Smaller requests are served from superblocks, which are packed together
+  * into huge pages (see mmapNewSuperBlocks).
+  */
+static size_t roundUpToHugePages(GC_state s, size_t numBlocks) {
+  if (HUGE_PAGES_NONE == s->controls->hugePages)
+    return numBlocks;
+
+  size_t blocksPerHugePage =
+    s->controls->hugePageSize / s->controls->blockSize;
+  if (numBlocks < blocksPerHugePage)
+    return numBlocks;
+
+  return align(numBlocks, blocksPerHugePage);
+}
+
+
+/** Whether mapping another `length` bytes keeps the heap within
+  * s->controls->maxHeap.
+  */
+static bool withinMaxHeap(GC_state s, size_t length) {
+  if (0 == s->controls->maxHeap)
+    return TRUE;
+
+  size_t mapped;
+  size_t inUse;
+  queryCurrentHeapBytes(s, &mapped, &inUse);
+  return mapped + length <= s->controls->maxHeap;
+}
+
+
+/** Called when every attempt to find or map `length` bytes has failed. If
+  * that is because of s->controls->maxHeap, say so, rather than reporting
+  * a generic failure. With huge pages, mmapBlockRegion may need up to one
+  * extra huge page for alignment.
+  */
+static void dieOutOfSpace(GC_state s, size_t length) {
+  if (HUGE_PAGES_NONE != s->controls->hugePages)
+    length += s->controls->hugePageSize;
+  if (withinMaxHeap(s, length))
+    DIE("ran out of space!");
+
+  size_t mapped;
+  size_t inUse;
+  queryCurrentHeapBytes(s, &mapped, &inUse);
+  die ("Out of memory with max-heap %s: %s bytes mapped (%s in use), "
+       "unable to map %s more.",
+       uintmaxToCommaString(s->controls->maxHeap),
+       uintmaxToCommaString(mapped),
+       uintmaxToCommaString(inUse),
+       uintmaxToCommaString(length));
+}
+
+
+/** Map at least *length bytes for blocks, updating *length to the amount
+  * actually mapped. With huge pages, the region is aligned to the huge page
+  * size, so that the kernel can back all of its interior with huge pages.
+  * Returns MAP_FAILED on failure, including when the mapping (counting any
+  * over-allocation) would exceed the max-heap.
+  */
+static pointer mmapBlockRegion(GC_state s, size_t *length) {
+  size_t hugePageSize = s->controls->hugePageSize;
+
+  switch (s->controls->hugePages) {
+  case HUGE_PAGES_NONE:
+    if (!withinMaxHeap(s, *length))
+      return MAP_FAILED;
+    return GC_mmapAnon(NULL, *length);
+
+  case HUGE_PAGES_HUGETLB: {
+    size_t hugeLength = align(*length, hugePageSize);
+    if (!withinMaxHeap(s, hugeLength))
+      return MAP_FAILED;
+    pointer start = GC_mmapAnonHuge(NULL, hugeLength);
+    if (MAP_FAILED != start) {
+      *length = hugeLength;
+      return start;
+    }
+    /** No reserved huge pages left; fall back on transparent huge pages. */
+  }
+  /* fall through */
+
+  case HUGE_PAGES_THP: {
+    /** Over-allocate, and trim to the aligned part. */
+    if (!withinMaxHeap(s, *length + hugePageSize))
+      return MAP_FAILED;
+    pointer start = GC_mmapAnon(NULL, *length + hugePageSize);
+    if (MAP_FAILED == start)
+      return MAP_FAILED;
+
+    pointer aligned = (pointer)align((size_t)start, hugePageSize);
+    if (aligned > start)
+      GC_release(start, (size_t)(aligned - start));
+    size_t tail = (size_t)((start + *length + hugePageSize) - (aligned + *length));
+    if (tail > 0)
+      GC_release(aligned + *length, tail);
+
+    GC_adviseHugePages(aligned, *length);
+    return aligned;
+  }
+  }
+
+  return MAP_FAILED;
+}
+
+
 static void unlinkSuperBlock(SuperBlockList list, SuperBlock sb) {
   if (NULL == sb->prevSuperBlock) {
     assert(list->firstSuperBlock == sb);
@@ -220,29 +421,44 @@ static void mmapNewSuperBlocks(
   BlockAllocator ball)
 {
   size_t oneWidth = s->controls->blockSize * (1 + SUPERBLOCK_SIZE(s));
-  size_t count = 1 + (s->controls->allocBlocksMinSize-1) / oneWidth;
+  size_t count = superBlocksPerMap(s);
   assert(count * oneWidth >= s->controls->allocBlocksMinSize);
-  pointer start = GC_mmapAnon(NULL, count * oneWidth);
+  size_t length = count * oneWidth;
+  pointer start = mmapBlockRegion(s, &length);
   if (MAP_FAILED == start) {
     /** Try again, but the minimum amount of space we actually need. */
-    count = 1;
-    start = GC_mmapAnon(NULL, oneWidth);
+    length = oneWidth;
+    start = mmapBlockRegion(s, &length);
     if (MAP_FAILED == start)
-      DIE("ran out of space!");
+      dieOutOfSpace(s, length);
   }
   assert(isAligned((size_t)start, s->controls->blockSize));
 
+  /** The region might be bigger than requested (with reserved huge pages),
+    * in which case we fill it with as many superblocks as fit. Superblocks
+    * are laid out back-to-back, so they straddle huge page boundaries
+    * rather than leaving gaps in them.
+    */
+  count = length / oneWidth;
+
+  /** Must happen before the loop below touches the superblock headers. */
+  if (s->controls->numaAware)
+    GC_numaBind(start, length, getNodePool(s)->numaNode);
+
   for (size_t i = 0; i < count; i++) {
     SuperBlock sb = (SuperBlock)(start + oneWidth * i);
     sb->owner = ball;
     sb->nextSuperBlock = NULL;
     sb->prevSuperBlock = NULL;
     sb->numBlocksFree = SUPERBLOCK_SIZE(s);
+    sb->emptySincePass = ball->decommitPass;
+    sb->isDecommitted = FALSE;
     sb->magic = 0xabaddeed;
     setSuperBlockSizeClass(s, sb, 0);
     prependSuperBlock(getFullnessGroup(s, ball, 0, COMPLETELY_EMPTY), sb);
   }
 
+  ball->numEmptySuperBlocks += count;
   ball->numBlocksMapped += count*(SUPERBLOCK_SIZE(s));
 }
 
@@ -256,6 +472,13 @@ static Blocks allocateInSuperBlock(
   if ((size_t)sb->numBlocksFree == SUPERBLOCK_SIZE(s)) {
     // It's completely empty! We can reuse.
     setSuperBlockSizeClass(s, sb, sizeClass);
+    if (sb->isDecommitted) {
+      // The pages will be faulted back in as they are touched.
+      sb->isDecommitted = FALSE;
+      __sync_fetch_and_sub(
+        &(s->blockAllocatorGlobal->numBlocksDecommitted),
+        SUPERBLOCK_SIZE(s));
+    }
   }
 
   assert(sb->sizeClass == sizeClass);
@@ -354,6 +577,8 @@ static Blocks tryAllocateAndAdjustSuperBlocks(
     unlinkSuperBlock(targetList, sb);
     SuperBlockList new = getFullnessGroup(s, ball, class, newfg);
     prependSuperBlock(new, sb);
+    if (fg == COMPLETELY_EMPTY)
+      ball->numEmptySuperBlocks--;
   }
 
   return result;
@@ -369,8 +594,63 @@ static void localFreeBlocks(GC_state s, SuperBlock sb, FreeBlock b) {
   SuperBlockList oldList = getFullnessGroup(s, ball, sb->sizeClass, fg);
   unlinkSuperBlock(oldList, sb);
   deallocateInSuperBlock(s, sb, b, sb->sizeClass);
-  SuperBlockList newList = getFullnessGroup(s, ball, sb->sizeClass, fullness(s, sb));
-  prependSuperBlock(newList, sb);
+  enum FullnessGroup newfg = fullness(s, sb);
+
+  if (newfg != COMPLETELY_EMPTY) {
+    SuperBlockList newList = getFullnessGroup(s, ball, sb->sizeClass, newfg);
+    prependSuperBlock(newList, sb);
+    return;
+  }
+
+  /** In NUMA-aware mode, we keep at most two mappings' worth of empty
+    * superblocks locally; beyond that they go back to the node pool, where
+    * other processors on the same node can pick them up.
+    */
+  if (s->controls->numaAware &&
+      ball->numEmptySuperBlocks >= 2 * superBlocksPerMap(s))
+  {
+    BlockAllocator pool = getNodePool(s);
+    sb->owner = pool;
+    pthread_mutex_lock(&(pool->superBlockLock));
+    sb->emptySincePass = pool->decommitPass;
+    prependSuperBlock(&(pool->completelyEmptyGroup), sb);
+    pool->numEmptySuperBlocks++;
+    pthread_mutex_unlock(&(pool->superBlockLock));
+    return;
+  }
+
+  sb->emptySincePass = ball->decommitPass;
+  prependSuperBlock(getFullnessGroup(s, ball, 0, COMPLETELY_EMPTY), sb);
+  ball->numEmptySuperBlocks++;
+}
+
+
+/** Move up to one mapping's worth of empty superblocks from the node pool
+  * into the local allocator. Returns the number moved.
+  */
+static size_t refillFromNodePool(GC_state s) {
+  BlockAllocator local = s->blockAllocatorLocal;
+  BlockAllocator pool = getNodePool(s);
+  size_t wanted = superBlocksPerMap(s);
+  size_t count = 0;
+
+  if (NULL == pool->completelyEmptyGroup.firstSuperBlock)
+    return 0;
+
+  pthread_mutex_lock(&(pool->superBlockLock));
+  while (count < wanted && NULL != pool->completelyEmptyGroup.firstSuperBlock) {
+    SuperBlock sb = pool->completelyEmptyGroup.firstSuperBlock;
+    unlinkSuperBlock(&(pool->completelyEmptyGroup), sb);
+    pool->numEmptySuperBlocks--;
+    sb->owner = local;
+    sb->emptySincePass = local->decommitPass;
+    prependSuperBlock(getFullnessGroup(s, local, 0, COMPLETELY_EMPTY), sb);
+    count++;
+  }
+  pthread_mutex_unlock(&(pool->superBlockLock));
+
+  local->numEmptySuperBlocks += count;
+  return count;
 }
 
 
@@ -392,6 +672,8 @@ static void clearOutOtherFrees(GC_state s) {
     FreeBlock next = topElem->nextFree;
     SuperBlock sb = topElem->container;
     assert( sb->owner == local );
+    s->cumulativeStatistics->numBlocksReclaimedFromOthers +=
+      (size_t)1 << sb->sizeClass;
     localFreeBlocks(s, sb, topElem);
 
     topElem = next;
@@ -406,8 +688,102 @@ static void clearOutOtherFrees(GC_state s) {
 }
 
 
+/** Move megablocks from the cache of this processor to `pool` until at most
+  * `keepBlocks` blocks are left in the cache, largest size classes first,
+  * under a single acquisition of the lock of the pool.
+  */
+static void flushMegaBlockCache(GC_state s, BlockAllocator pool, size_t keepBlocks) {
+  BlockAllocator local = s->blockAllocatorLocal;
+  size_t numMbSizeClasses =
+    s->controls->megablockThreshold - s->controls->superblockThreshold;
+  size_t count = 0;
+
+  lockMegaBlockPool(pool);
+  for (size_t i = numMbSizeClasses;
+       i > 0 && local->numCachedMegaBlockBlocks > keepBlocks;
+       i--)
+  {
+    MegaBlockList list = &(local->megaBlockSizeClass[i-1]);
+    while (NULL != list->firstMegaBlock
+           && local->numCachedMegaBlockBlocks > keepBlocks)
+    {
+      MegaBlock mb = list->firstMegaBlock;
+      list->firstMegaBlock = mb->nextMegaBlock;
+      local->numCachedMegaBlockBlocks -= mb->numBlocks;
+      mb->emptySincePass = pool->decommitPass;
+      mb->nextMegaBlock = pool->megaBlockSizeClass[i-1].firstMegaBlock;
+      pool->megaBlockSizeClass[i-1].firstMegaBlock = mb;
+      count++;
+    }
+  }
+  pthread_mutex_unlock(&(pool->megaBlockLock));
+
+  LOG(LM_CHUNK_POOL, LL_INFO,
+    "returned %zu cached megablocks (%zu blocks still cached)",
+    count,
+    local->numCachedMegaBlockBlocks);
+}
+
+
+/** Whether the heap is past s->controls->targetHeap (which max-heap implies).
+  * The megablock cache of a processor is invisible to the others, so it is
+  * not used past the target: its blocks would still count as mapped while
+  * other processors run out of room.
+  */
+static bool megaBlockCacheOverBudget(GC_state s) {
+  return 0 != s->controls->targetHeap
+    && getRecentHeapBytesInUse(s) > s->controls->targetHeap;
+}
+
+
+/** Return every cached megablock of this processor to its shared pool. */
+static void flushWholeMegaBlockCache(GC_state s) {
+  if (0 == s->blockAllocatorLocal->numCachedMegaBlockBlocks)
+    return;
+  flushMegaBlockCache(s,
+    getMegaBlockPool(s,
+      s->controls->numaAware ? getNodePool(s)->numaNode : 0),
+    0);
+}
+
+
+/** Remove and return the first megablock of at least `numBlocksNeeded` blocks
+  * in size classes [lower, upper) of `ball`, or NULL. The caller must own
+  * `ball` or hold its megaBlockLock.
+  */
+static MegaBlock takeMegaBlock(
+  BlockAllocator ball,
+  size_t numBlocksNeeded,
+  size_t lower,
+  size_t upper,
+  size_t *count)
+{
+  for (size_t i = lower; i < upper; i++) {
+    for (MegaBlock *mbp = &(ball->megaBlockSizeClass[i].firstMegaBlock);
+         *mbp != NULL;
+         mbp = &((*mbp)->nextMegaBlock))
+    {
+      MegaBlock mb = *mbp;
+      (*count)++;
+
+      if (mb->numBlocks >= numBlocksNeeded) {
+        *mbp = mb->nextMegaBlock;
+        mb->nextMegaBlock = NULL;
+        return mb;
+      }
+    }
+  }
+
+  return NULL;
+}
+
+
 static void freeMegaBlock(GC_state s, MegaBlock mb, size_t sizeClass) {
-  BlockAllocator global = s->blockAllocatorGlobal;
+  /** Return it to the pool of the node it lives on, which is not
+    * necessarily the node of this processor. */
+  BlockAllocator global =
+    getMegaBlockPool(s,
+      s->controls->numaAware ? GC_numaNodeOfAddress((void*)mb) : 0);
   size_t nb = mb->numBlocks;
   enum BlockPurpose purpose = mb->purpose;
 
@@ -428,13 +804,32 @@ static void freeMegaBlock(GC_state s, MegaBlock mb, size_t sizeClass) {
   }
 
   size_t mbClass = sizeClass - s->controls->superblockThreshold;
+  __sync_fetch_and_add(&(global->numBlocksFreed[purpose]), nb);
 
-  pthread_mutex_lock(&(global->megaBlockLock));
+  /** Keep it for this processor if it fits in the cache (and, in NUMA-aware
+    * mode, lives on this processor's node). */
+  BlockAllocator local = s->blockAllocatorLocal;
+  size_t cacheBlocks = s->controls->megablockCacheSize / s->controls->blockSize;
+  if (nb <= cacheBlocks
+      && (!s->controls->numaAware || getNodePool(s) == global)
+      && !megaBlockCacheOverBudget(s))
+  {
+    mb->emptySincePass = local->decommitPass;
+    mb->isDecommitted = FALSE;
+    mb->nextMegaBlock = local->megaBlockSizeClass[mbClass].firstMegaBlock;
+    local->megaBlockSizeClass[mbClass].firstMegaBlock = mb;
+    local->numCachedMegaBlockBlocks += nb;
+    if (local->numCachedMegaBlockBlocks > cacheBlocks)
+      flushMegaBlockCache(s, global, cacheBlocks / 2);
+    return;
+  }
+
+  lockMegaBlockPool(global);
+  mb->emptySincePass = global->decommitPass;
+  mb->isDecommitted = FALSE;
   mb->nextMegaBlock = global->megaBlockSizeClass[mbClass].firstMegaBlock;
   global->megaBlockSizeClass[mbClass].firstMegaBlock = mb;
   pthread_mutex_unlock(&(global->megaBlockLock));
-
-  __sync_fetch_and_add(&(global->numBlocksFreed[purpose]), nb);
   return;
 }
 
@@ -445,7 +840,8 @@ static MegaBlock tryFindMegaBlock(
   size_t sizeClass,
   enum BlockPurpose purpose)
 {
-  BlockAllocator global = s->blockAllocatorGlobal;
+  BlockAllocator global =
+    getMegaBlockPool(s, s->controls->numaAware ? getNodePool(s)->numaNode : 0);
   assert(sizeClass >= s->controls->superblockThreshold);
 
   if (sizeClass >= s->controls->megablockThreshold)
@@ -453,55 +849,63 @@ static MegaBlock tryFindMegaBlock(
 
   size_t numMbSizeClasses =
     s->controls->megablockThreshold - s->controls->superblockThreshold;
-
-  pthread_mutex_lock(&(global->megaBlockLock));
-
   size_t lower = sizeClass - s->controls->superblockThreshold;
   size_t upper = min(lower+2, numMbSizeClasses);
   size_t count = 0;
 
-  for (size_t i = lower; i < upper; i++) {
-    for (MegaBlock *mbp = &(global->megaBlockSizeClass[i].firstMegaBlock);
-         *mbp != NULL;
-         mbp = &((*mbp)->nextMegaBlock))
-    {
-      MegaBlock mb = *mbp;
-      count++;
+  /** The cache of this processor first, which needs no lock. */
+  BlockAllocator local = s->blockAllocatorLocal;
+  MegaBlock mb = takeMegaBlock(local, numBlocksNeeded, lower, upper, &count);
+  if (NULL != mb) {
+    local->numCachedMegaBlockBlocks -= mb->numBlocks;
+  }
+  else {
+    lockMegaBlockPool(global);
+    mb = takeMegaBlock(global, numBlocksNeeded, lower, upper, &count);
+    pthread_mutex_unlock(&(global->megaBlockLock));
+  }
 
-      if (mb->numBlocks >= numBlocksNeeded) {
-        *mbp = mb->nextMegaBlock;
-        mb->nextMegaBlock = NULL;
-        pthread_mutex_unlock(&(global->megaBlockLock));
+  if (NULL == mb)
+    return NULL;
 
-        __sync_fetch_and_add(&(global->numBlocksAllocated[purpose]), mb->numBlocks);
+  if (mb->isDecommitted) {
+    mb->isDecommitted = FALSE;
+    __sync_fetch_and_sub(
+      &(s->blockAllocatorGlobal->numBlocksDecommitted),
+      mb->numBlocks - 1);
+  }
 
-        LOG(LM_CHUNK_POOL, LL_INFO,
-          "inspected %zu, satisfied large alloc of %zu blocks using megablock of %zu",
-          count,
-          numBlocksNeeded,
-          mb->numBlocks);
+  __sync_fetch_and_add(&(global->numBlocksAllocated[purpose]), mb->numBlocks);
 
-        return mb;
-      }
-    }
-  }
+  LOG(LM_CHUNK_POOL, LL_INFO,
+    "inspected %zu, satisfied large alloc of %zu blocks using megablock of %zu",
+    count,
+    numBlocksNeeded,
+    mb->numBlocks);
 
-  pthread_mutex_unlock(&(global->megaBlockLock));
-  return NULL;
+  return mb;
 }
 
 
 static MegaBlock mmapNewMegaBlock(GC_state s, size_t numBlocks, enum BlockPurpose purpose)
 {
-  pointer start = GC_mmapAnon(NULL, s->controls->blockSize * numBlocks);
+  size_t length = s->controls->blockSize * numBlocks;
+  pointer start = mmapBlockRegion(s, &length);
   if (MAP_FAILED == start) {
     return NULL;
   }
+  numBlocks = length / s->controls->blockSize;
   if (!isAligned((size_t)start, s->controls->blockSize)) {
     DIE("whoops, mmap didn't align by the block-size.");
   }
 
-  BlockAllocator global = s->blockAllocatorGlobal;
+  uint32_t node = 0;
+  if (s->controls->numaAware) {
+    node = getNodePool(s)->numaNode;
+    GC_numaBind(start, s->controls->blockSize * numBlocks, node);
+  }
+
+  BlockAllocator global = getMegaBlockPool(s, node);
   __sync_fetch_and_add(&(global->numBlocksMapped), numBlocks);
   __sync_fetch_and_add(&(global->numBlocksAllocated[purpose]), numBlocks);
 
@@ -525,6 +929,8 @@ Blocks allocateBlocksWithPurpose(GC_state s, size_t numBlocks, enum BlockPurpose
   int class = computeSizeClass(numBlocks);
 
   if ((size_t)class >= s->controls->superblockThreshold) {
+    numBlocks = roundUpToHugePages(s, numBlocks);
+    class = computeSizeClass(numBlocks);
 
     /** First see if we can reuse. If not, try mmap a new one. If that all
       * fails, we're a bit screwed.
@@ -536,7 +942,7 @@ Blocks allocateBlocksWithPurpose(GC_state s, size_t numBlocks, enum BlockPurpose
       mb = mmapNewMegaBlock(s, numBlocks, purpose);
 
     if (NULL == mb)
-      DIE("ran out of space!");
+      dieOutOfSpace(s, numBlocks * s->controls->blockSize);
 
     size_t actualNumBlocks = mb->numBlocks;
     assert(actualNumBlocks >= numBlocks);
@@ -558,8 +964,10 @@ Blocks allocateBlocksWithPurpose(GC_state s, size_t numBlocks, enum BlockPurpose
     return result;
   }
 
-  /** If both local fails, we need to mmap new superchunks. */
-  mmapNewSuperBlocks(s, local);
+  /** If local fails, try the node pool, and otherwise we need to mmap new
+    * superchunks. */
+  if (!s->controls->numaAware || 0 == refillFromNodePool(s))
+    mmapNewSuperBlocks(s, local);
 
   result = tryAllocateAndAdjustSuperBlocks(s, local, class, purpose);
   if (result == NULL) {
@@ -572,6 +980,58 @@ Blocks allocateBlocksWithPurpose(GC_state s, size_t numBlocks, enum BlockPurpose
 }
 
 
+/** Hand a whole batch to its owner with a single CAS. The owner takes
+  * them in at its convenience (see clearOutOtherFrees).
+  */
+static void publishRemoteFreeBatch(GC_state s, RemoteFreeBatch batch) {
+  BlockAllocator owner = batch->owner;
+  assert(NULL != owner && NULL != batch->first && NULL != batch->last);
+
+  while (TRUE) {
+    FreeBlock oldVal = owner->firstFreedByOther;
+    batch->last->nextFree = oldVal;
+    if (__sync_bool_compare_and_swap(&(owner->firstFreedByOther), oldVal, batch->first))
+      break;
+  }
+
+  s->cumulativeStatistics->numRemoteFreeBatches++;
+  batch->owner = NULL;
+  batch->first = NULL;
+  batch->last = NULL;
+  batch->count = 0;
+}
+
+
+/** The batch for `owner`, or an empty one claimed for it. If all slots are
+  * taken by other owners, the fullest batch is published to make room.
+  */
+static RemoteFreeBatch getRemoteFreeBatch(GC_state s, BlockAllocator owner) {
+  BlockAllocator local = s->blockAllocatorLocal;
+  RemoteFreeBatch empty = NULL;
+  RemoteFreeBatch fullest = NULL;
+
+  for (int i = 0; i < NUM_REMOTE_FREE_BATCHES; i++) {
+    RemoteFreeBatch batch = &(local->remoteFreeBatches[i]);
+    if (batch->owner == owner)
+      return batch;
+    if (NULL == batch->owner) {
+      if (NULL == empty) empty = batch;
+    }
+    else if (NULL == fullest || batch->count > fullest->count) {
+      fullest = batch;
+    }
+  }
+
+  if (NULL == empty) {
+    publishRemoteFreeBatch(s, fullest);
+    empty = fullest;
+  }
+
+  empty->owner = owner;
+  return empty;
+}
+
+
 Blocks allocateBlocks(GC_state s, size_t numBlocks) {
   return allocateBlocksWithPurpose(s, numBlocks, BLOCK_FOR_UNKNOWN_PURPOSE);
 }
@@ -648,12 +1108,210 @@ void freeBlocks(GC_state s, Blocks bs, writeFreedBlockInfoFnClosure f) {
     return;
   }
 
-  /** Otherwise, enqueue for the other proc to handle. */
-  while (TRUE) {
-    FreeBlock oldVal = owner->firstFreedByOther;
-    elem->nextFree = oldVal;
-    if (__sync_bool_compare_and_swap(&(owner->firstFreedByOther), oldVal, elem))
-      break;
+  /** Otherwise, batch it up for the other proc to handle. */
+  s->cumulativeStatistics->numBlocksFreedForOthers += numBlocks;
+  RemoteFreeBatch batch = getRemoteFreeBatch(s, owner);
+  elem->nextFree = batch->first;
+  batch->first = elem;
+  if (NULL == batch->last)
+    batch->last = elem;
+  batch->count++;
+  if (batch->count >= REMOTE_FREE_BATCH_SIZE)
+    publishRemoteFreeBatch(s, batch);
+}
+
+
+void publishRemoteFrees(GC_state s) {
+  BlockAllocator local = s->blockAllocatorLocal;
+  for (int i = 0; i < NUM_REMOTE_FREE_BATCHES; i++) {
+    if (0 != local->remoteFreeBatches[i].count)
+      publishRemoteFreeBatch(s, &(local->remoteFreeBatches[i]));
+  }
+}
+
+
+void reclaimRemoteFrees(GC_state s) {
+  publishRemoteFrees(s);
+  clearOutOtherFrees(s);
+}
+
+
+static inline bool idleSincePass(size_t emptySincePass, size_t currentPass) {
+  return emptySincePass + 2 <= currentPass;
+}
+
+
+/** Decommit empty superblocks of `ball` that have been empty since at least
+  * two passes ago, or all of them if `all`. The caller must either own
+  * `ball`, or hold its superBlockLock. Returns the number of blocks
+  * decommitted, which are already added to numBlocksDecommitted: whoever
+  * recommits them subtracts under the same lock, so the count must not lag
+  * behind the flags.
+  */
+static size_t decommitEmptySuperBlocks(GC_state s, BlockAllocator ball, bool all) {
+  size_t count = 0;
+
+  for (SuperBlock sb = ball->completelyEmptyGroup.firstSuperBlock;
+       NULL != sb;
+       sb = sb->nextSuperBlock)
+  {
+    assert((size_t)sb->numBlocksFree == SUPERBLOCK_SIZE(s));
+    if (sb->isDecommitted ||
+        !(all || idleSincePass(sb->emptySincePass, ball->decommitPass)))
+      continue;
+
+    /** The freelist lives inside the blocks, so forget it first. */
+    setSuperBlockSizeClass(s, sb, 0);
+    if (!GC_decommit(
+          (pointer)sb + s->controls->blockSize,
+          SUPERBLOCK_SIZE(s) * s->controls->blockSize))
+      continue;
+    sb->isDecommitted = TRUE;
+    count += SUPERBLOCK_SIZE(s);
+  }
+
+  if (count > 0)
+    __sync_fetch_and_add(
+      &(s->blockAllocatorGlobal->numBlocksDecommitted), count);
+  return count;
+}
+
+
+/** Same as decommitEmptySuperBlocks, for the free megablocks of `pool`. The
+  * caller must hold the megaBlockLock of `pool`, or own it (for the megablock
+  * cache of a local allocator). The megablock header (the first block) stays
+  * committed.
+  */
+static size_t decommitFreeMegaBlocks(GC_state s, BlockAllocator pool, bool all) {
+  size_t numMbSizeClasses =
+    s->controls->megablockThreshold - s->controls->superblockThreshold;
+  size_t count = 0;
+
+  for (size_t i = 0; i < numMbSizeClasses; i++) {
+    for (MegaBlock mb = pool->megaBlockSizeClass[i].firstMegaBlock;
+         NULL != mb;
+         mb = mb->nextMegaBlock)
+    {
+      if (mb->isDecommitted || mb->numBlocks < 2 ||
+          !(all || idleSincePass(mb->emptySincePass, pool->decommitPass)))
+        continue;
+
+      if (!GC_decommit(
+            (pointer)mb + s->controls->blockSize,
+            (mb->numBlocks - 1) * s->controls->blockSize))
+        continue;
+      mb->isDecommitted = TRUE;
+      count += mb->numBlocks - 1;
+    }
+  }
+
+  if (count > 0)
+    __sync_fetch_and_add(
+      &(s->blockAllocatorGlobal->numBlocksDecommitted), count);
+  return count;
+}
+
+
+/** A decommit pass over a shared pool (the global allocator or a node pool).
+  * Skipped if some other processor is using the pool, or did a pass
+  * recently.
+  */
+static size_t maybeDecommitPool(
+  GC_state s,
+  BlockAllocator pool,
+  struct timespec *now,
+  bool all)
+{
+  if (0 != pthread_mutex_trylock(&(pool->megaBlockLock)))
+    return 0;
+
+  if (!all && !timespec_geq(now, &(pool->nextDecommitPass))) {
+    pthread_mutex_unlock(&(pool->megaBlockLock));
+    return 0;
+  }
+
+  pool->nextDecommitPass = *now;
+  timespec_add(&(pool->nextDecommitPass), &(s->controls->decommitDelay));
+  pool->decommitPass++;
+
+  size_t count = decommitFreeMegaBlocks(s, pool, all);
+
+  if (0 == pthread_mutex_trylock(&(pool->superBlockLock))) {
+    count += decommitEmptySuperBlocks(s, pool, all);
+    pthread_mutex_unlock(&(pool->superBlockLock));
+  }
+
+  pthread_mutex_unlock(&(pool->megaBlockLock));
+  return count;
+}
+
+
+static bool exceedsTargetRSS(GC_state s) {
+  if (0 == s->controls->targetRSS)
+    return FALSE;
+
+  size_t mapped;
+  size_t globalMapped;
+  size_t released;
+  size_t globalReleased;
+  size_t decommitted;
+  size_t allocated[NUM_BLOCK_PURPOSES];
+  size_t freed[NUM_BLOCK_PURPOSES];
+  size_t contended;
+  queryCurrentBlockUsage(
+    s,
+    &mapped,
+    &globalMapped,
+    &released,
+    &globalReleased,
+    &decommitted,
+    (size_t*)allocated,
+    (size_t*)freed,
+    &contended
+  );
+
+  if (released + decommitted >= mapped)
+    return FALSE;
+
+  size_t resident = mapped - released - decommitted;
+  return resident * s->controls->blockSize > s->controls->targetRSS;
+}
+
+
+void maybeDecommitIdleBlocks(GC_state s) {
+  BlockAllocator local = s->blockAllocatorLocal;
+  BlockAllocator global = s->blockAllocatorGlobal;
+
+  /** Past the heap target, make cached megablocks available to everyone. */
+  if (0 != local->numCachedMegaBlockBlocks && megaBlockCacheOverBudget(s))
+    flushWholeMegaBlockCache(s);
+
+  struct timespec now;
+  timespec_now(&now);
+  if (!timespec_geq(&now, &(local->nextDecommitPass)))
+    return;
+
+  local->nextDecommitPass = now;
+  timespec_add(&(local->nextDecommitPass), &(s->controls->decommitDelay));
+  local->decommitPass++;
+
+  bool all = exceedsTargetRSS(s);
+
+  /** Blocks freed by other processors might complete some superblocks. */
+  clearOutOtherFrees(s);
+  size_t count = decommitEmptySuperBlocks(s, local, all);
+  count += decommitFreeMegaBlocks(s, local, all);
+
+  count += maybeDecommitPool(s, global, &now, all);
+  for (uint32_t node = 0; node < global->numNodePools; node++) {
+    count += maybeDecommitPool(s, &(global->nodePools[node]), &now, all);
+  }
+
+  if (count > 0) {
+    LOG(LM_BLOCK_ALLOCATOR, LL_INFO,
+      "decommitted %zu blocks%s",
+      count,
+      all ? " (above target RSS)" : "");
   }
 }
 
@@ -664,13 +1322,17 @@ void queryCurrentBlockUsage(
   size_t *numGlobalBlocksMapped,
   size_t *numBlocksReleased,
   size_t *numGlobalBlocksReleased,
+  size_t *numBlocksDecommitted,
   size_t *numBlocksAllocated,
-  size_t *numBlocksFreed)
+  size_t *numBlocksFreed,
+  size_t *numMegaBlockLockContended)
 {
+  *numMegaBlockLockContended = 0;
   *numBlocksMapped = 0;
   *numGlobalBlocksMapped = 0;
   *numBlocksReleased = 0;
   *numGlobalBlocksReleased = 0;
+  *numBlocksDecommitted = s->blockAllocatorGlobal->numBlocksDecommitted;
   for (enum BlockPurpose p = 0; p < NUM_BLOCK_PURPOSES; p++) {
     numBlocksAllocated[p] = 0;
     numBlocksFreed[p] = 0;
@@ -698,6 +1360,111 @@ void queryCurrentBlockUsage(
 
   *numGlobalBlocksMapped += global->numBlocksMapped;
   *numGlobalBlocksReleased += global->numBlocksReleased;
+  *numMegaBlockLockContended += global->numMegaBlockLockContended;
+
+  // query node pools, which count as global
+  for (uint32_t node = 0; node < global->numNodePools; node++) {
+    BlockAllocator pool = &(global->nodePools[node]);
+    *numBlocksMapped += pool->numBlocksMapped;
+    *numBlocksReleased += pool->numBlocksReleased;
+    for (enum BlockPurpose p = 0; p < NUM_BLOCK_PURPOSES; p++) {
+      numBlocksAllocated[p] += pool->numBlocksAllocated[p];
+      numBlocksFreed[p] += pool->numBlocksFreed[p];
+    }
+    *numGlobalBlocksMapped += pool->numBlocksMapped;
+    *numGlobalBlocksReleased += pool->numBlocksReleased;
+    *numMegaBlockLockContended += pool->numMegaBlockLockContended;
+  }
+}
+
+
+void queryCurrentHeapBytes(GC_state s, size_t *bytesMapped, size_t *bytesInUse) {
+  size_t mapped;
+  size_t globalMapped;
+  size_t released;
+  size_t globalReleased;
+  size_t decommitted;
+  size_t allocated[NUM_BLOCK_PURPOSES];
+  size_t freed[NUM_BLOCK_PURPOSES];
+  size_t contended;
+  queryCurrentBlockUsage(
+    s,
+    &mapped,
+    &globalMapped,
+    &released,
+    &globalReleased,
+    &decommitted,
+    (size_t*)allocated,
+    (size_t*)freed,
+    &contended
+  );
+
+  size_t inUse = 0;
+  for (enum BlockPurpose p = 0; p < NUM_BLOCK_PURPOSES; p++) {
+    if (allocated[p] > freed[p])
+      inUse += allocated[p] - freed[p];
+  }
+
+  *bytesMapped = (mapped > released ? mapped - released : 0) * s->controls->blockSize;
+  *bytesInUse = inUse * s->controls->blockSize;
+}
+
+
+#define HEAP_USAGE_SAMPLE_INTERVAL_NS 10000000
+
+static void sampleHeapBytesInUse(
+  GC_state s,
+  __attribute__((unused)) struct timespec *now,
+  __attribute__((unused)) void *env)
+{
+  size_t mapped;
+  size_t inUse;
+  queryCurrentHeapBytes(s, &mapped, &inUse);
+  __atomic_store_n(&(s->blockAllocatorGlobal->recentBytesInUse), inUse,
+                   __ATOMIC_RELAXED);
+}
+
+
+size_t getRecentHeapBytesInUse(GC_state s) {
+  maybeSample(s, s->heapUsageSampler);
+  return __atomic_load_n(&(s->blockAllocatorGlobal->recentBytesInUse),
+                         __ATOMIC_RELAXED);
+}
+
+
+/** In NUMA-aware mode, log the number of blocks currently mapped on each
+  * node. Blocks are attributed to the node of the processor that mapped
+  * them, which is where they were bound.
+  */
+static void logCurrentBlockUsageByNode(GC_state s) {
+  BlockAllocator global = s->blockAllocatorGlobal;
+
+  for (uint32_t node = 0; node < global->numNodePools; node++) {
+    BlockAllocator pool = &(global->nodePools[node]);
+    size_t mapped = pool->numBlocksMapped;
+    size_t released = pool->numBlocksReleased;
+
+    for (uint32_t i = 0; i < s->numberOfProcs; i++) {
+      BlockAllocator ball = s->procStates[i].blockAllocatorLocal;
+      if (ball->nodePool == pool) {
+        mapped += ball->numBlocksMapped;
+        released += ball->numBlocksReleased;
+      }
+    }
+
+    size_t count = mapped-released;
+    if (released > mapped) count = 0;
+
+    LOG(LM_BLOCK_ALLOCATOR, LL_INFO,
+      "block-allocator node %"PRIu32"\n"
+      "  currently mapped           %zu (= %zu - %zu)\n"
+      "  pooled empty superblocks   %zu\n",
+      node,
+      count,
+      mapped,
+      released,
+      pool->numEmptySuperBlocks);
+  }
 }
 
 
@@ -710,16 +1477,20 @@ void logCurrentBlockUsage(
   size_t globalMapped;
   size_t released;
   size_t globalReleased;
+  size_t decommitted;
   size_t allocated[NUM_BLOCK_PURPOSES];
   size_t freed[NUM_BLOCK_PURPOSES];
+  size_t contended;
   queryCurrentBlockUsage(
     s,
     &mapped,
     &globalMapped,
     &released,
     &globalReleased,
+    &decommitted,
     (size_t*)allocated,
-    (size_t*)freed
+    (size_t*)freed,
+    &contended
   );
 
   size_t inUse[NUM_BLOCK_PURPOSES];
@@ -742,6 +1513,8 @@ void logCurrentBlockUsage(
     "block-allocator(%zu.%.9zu)\n"
     "  currently mapped           %zu (= %zu - %zu)\n"
     "  currently mapped (global)  %zu (= %zu - %zu)\n"
+    "  currently decommitted      %zu\n"
+    "  megablock lock contended   %zu\n"
     "  BLOCK_FOR_HEAP_CHUNK       %zu (%zu%%) (= %zu - %zu)\n"
     "  BLOCK_FOR_REMEMBERED_SET   %zu (%zu%%) (= %zu - %zu)\n"
     "  BLOCK_FOR_FORGOTTEN_SET    %zu (%zu%%) (= %zu - %zu)\n"
@@ -761,6 +1534,10 @@ void logCurrentBlockUsage(
     globalMapped,
     globalReleased,
 
+    decommitted,
+
+    contended,
+
     inUse[BLOCK_FOR_HEAP_CHUNK],
     (size_t)(100.0 * (double)inUse[BLOCK_FOR_HEAP_CHUNK] / (double)count),
     allocated[BLOCK_FOR_HEAP_CHUNK],
@@ -805,6 +1582,9 @@ void logCurrentBlockUsage(
     (size_t)(100.0 * (double)inUse[BLOCK_FOR_UNKNOWN_PURPOSE] / (double)count),
     allocated[BLOCK_FOR_UNKNOWN_PURPOSE],
     freed[BLOCK_FOR_UNKNOWN_PURPOSE]);
+
+  if (s->controls->numaAware)
+    logCurrentBlockUsageByNode(s);
 }
 
 Sampler newBlockUsageSampler(GC_state s) {
@@ -819,4 +1599,18 @@ Sampler newBlockUsageSampler(GC_state s) {
   return result;
 }
 
+Sampler newHeapUsageSampler(GC_state s) {
+  struct SamplerClosure func;
+  func.fun = sampleHeapBytesInUse;
+  func.env = NULL;
+
+  struct timespec desiredInterval;
+  desiredInterval.tv_sec = 0;
+  desiredInterval.tv_nsec = HEAP_USAGE_SAMPLE_INTERVAL_NS;
+  Sampler result = malloc(sizeof(struct Sampler));
+  initSampler(s, result, &func, &desiredInterval);
+
+  return result;
+}
+
 #endif
@@ -69,6 +69,21 @@ typedef struct FreeBlock {
 struct BlockAllocator;
 
 
+/** Blocks freed by this processor but owned by the local allocator of
+  * another, waiting to be published to the owner as one list (see
+  * freeBlocks). Linked through nextFree, from first to last.
+  */
+#define NUM_REMOTE_FREE_BATCHES 8
+#define REMOTE_FREE_BATCH_SIZE 64
+
+typedef struct RemoteFreeBatch {
+  struct BlockAllocator *owner;
+  FreeBlock first;
+  FreeBlock last;
+  size_t count;
+} *RemoteFreeBatch;
+
+
 typedef struct SuperBlock {
 
   struct BlockAllocator *owner;
@@ -102,6 +117,14 @@ typedef struct SuperBlock {
   struct SuperBlock *nextSuperBlock;
   struct SuperBlock *prevSuperBlock;
 
+  /** Only meaningful while completely empty: the owner's decommitPass at the
+    * time the superblock became empty, and whether its blocks have been
+    * given back to the OS since then. The superblock header (the first
+    * block) is never decommitted.
+    */
+  size_t emptySincePass;
+  bool isDecommitted;
+
   /** For sanity checks. */
   uint32_t magic;
 
@@ -119,6 +142,9 @@ typedef struct MegaBlock {
   struct MegaBlock *nextMegaBlock;
   size_t numBlocks;
   enum BlockPurpose purpose;
+  /** Same as the corresponding fields of SuperBlock, for free megablocks. */
+  size_t emptySincePass;
+  bool isDecommitted;
 } *MegaBlock;
 
 
@@ -164,11 +190,68 @@ typedef struct BlockAllocator {
     */
   FreeBlock firstFreedByOther;
 
-  /** Only used in the global allocator (always NULL in the local allocators).
+  /** Local allocators only: blocks this proc freed for other procs, batched
+    * by owner. A batch is published to firstFreedByOther of its owner when
+    * it is full, when its slot is needed for another owner, or by
+    * publishRemoteFrees.
+    */
+  struct RemoteFreeBatch remoteFreeBatches[NUM_REMOTE_FREE_BATCHES];
+
+  /** Free megablocks, by size class. In the global allocator and in the
+    * per-node pools, these are shared and protected by megaBlockLock. In a
+    * local allocator, they are a small cache of megablocks recently freed by
+    * this processor, which only this processor touches (see freeMegaBlock).
     */
   struct MegaBlockList *megaBlockSizeClass;
   pthread_mutex_t megaBlockLock;
 
+  /** Local allocators only: number of blocks in the megablock cache. */
+  size_t numCachedMegaBlockBlocks;
+
+  /** Shared pools only: number of times megaBlockLock was already held by
+    * another processor when this one wanted it.
+    */
+  size_t numMegaBlockLockContended;
+
+  /** Number of superblocks in the completelyEmptyGroup. */
+  size_t numEmptySuperBlocks;
+
+  /** Decommit passes over free superblocks and megablocks; see
+    * maybeDecommitIdleBlocks. Superblocks and megablocks that have been
+    * free since two passes ago are decommitted.
+    */
+  size_t decommitPass;
+  struct timespec nextDecommitPass;
+
+  /** Only used in the global allocator: number of blocks currently
+    * decommitted, across all allocators.
+    */
+  size_t numBlocksDecommitted;
+
+  /** Only used in the global allocator: bytes of heap blocks in use, as of
+    * the last heap usage sample (see getRecentHeapBytesInUse).
+    */
+  size_t recentBytesInUse;
+
+  /** NUMA-aware mode only (see s->controls->numaAware).
+    *
+    * The global allocator has one pool per node, which sits between the
+    * local allocators and the global allocator. Local allocators hand
+    * their surplus of completely empty superblocks back to the pool of
+    * their node, and refill from it before mapping more memory. In this
+    * mode, megablocks are also kept in the per-node pools rather than in the
+    * global allocator.
+    *
+    * For a local allocator, nodePool is the pool of its node, or NULL if
+    * this has not been determined yet. The completelyEmptyGroup of a pool is
+    * protected by its superBlockLock.
+    */
+  uint32_t numaNode;
+  struct BlockAllocator *nodePool;
+  struct BlockAllocator *nodePools;
+  uint32_t numNodePools;
+  pthread_mutex_t superBlockLock;
+
 } *BlockAllocator;
 
 
@@ -200,11 +283,38 @@ Blocks allocateBlocksWithPurpose(GC_state s, size_t numBlocks, enum BlockPurpose
 /** Free a group of contiguous blocks. */
 void freeBlocks(GC_state s, Blocks bs, writeFreedBlockInfoFnClosure f);
 
+/** Publish all of the blocks that this processor freed on behalf of other
+  * processors and is still holding in its batches.
+  */
+void publishRemoteFrees(GC_state s);
+
+/** publishRemoteFrees, and also take in the blocks that other processors
+  * have published for this one. Meant for when this processor is idle.
+  */
+void reclaimRemoteFrees(GC_state s);
+
+
+/** Give the physical memory of blocks that have been free for a while back
+  * to the OS, at most once every s->controls->decommitDelay. If the amount
+  * of memory that is mapped and not decommitted exceeds
+  * s->controls->targetRSS, all free blocks are decommitted, regardless of
+  * how long they have been free.
+  *
+  * Only touches the local allocator of s, and the shared pools if they are
+  * not contended, so this is safe to call at any time from the processor
+  * that owns s.
+  */
+void maybeDecommitIdleBlocks(GC_state s);
 
 /** populate:
   *   *numBlocks := current total number of blocks mmap'ed
+  *   *numBlocksDecommitted := current number of mapped blocks that were
+  *                            given back to the OS (see maybeDecommitIdleBlocks)
   *   blocksAllocated[p] := cumulative number of blocks allocated for purpose `p`
   *   blocksFreed[p] := cumulative number of blocks freed for purpose `p`
+  *   *numMegaBlockLockContended := cumulative number of times a processor
+  *                                 had to wait for the lock of a shared
+  *                                 megablock pool
   *
   * The `blocksAllocated` and `blocksFreed` arrays must have length `NUM_BLOCK_PURPOSES`
   */
@@ -214,10 +324,29 @@ void queryCurrentBlockUsage(
   size_t *numGlobalBlocksMapped,
   size_t *numBlocksReleased,
   size_t *numGlobalBlocksReleased,
+  size_t *numBlocksDecommitted,
   size_t *blocksAllocated,
-  size_t *blocksFreed);
+  size_t *blocksFreed,
+  size_t *numMegaBlockLockContended);
+
+/** populate:
+  *   *bytesMapped := bytes of heap blocks that are mapped and not released,
+  *                   including free blocks kept for reuse
+  *   *bytesInUse := bytes of heap blocks that are currently allocated
+  *
+  * Sums over all processors without synchronization, so the result may be
+  * slightly stale.
+  */
+void queryCurrentHeapBytes(GC_state s, size_t *bytesMapped, size_t *bytesInUse);
+
+/** Like the bytesInUse of queryCurrentHeapBytes, but refreshed at most once
+  * every HEAP_USAGE_SAMPLE_INTERVAL_NS (by whichever processor asks first),
+  * so that frequent callers don't read the counters of every processor.
+  */
+size_t getRecentHeapBytesInUse(GC_state s);
 
 Sampler newBlockUsageSampler(GC_state s);
+Sampler newHeapUsageSampler(GC_state s);
 
 #endif
 
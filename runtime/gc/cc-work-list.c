@@ -93,6 +93,12 @@ bool makeInitialElem(GC_state s, objptr op, CC_workList_elem result) {
     return TRUE;
   }
 
+  if (WEAK_TAG == tag) {
+    // the target of a weak is never traced (see CC_clearWeaks and
+    // LGC_processWeaks)
+    return FALSE;
+  }
+
   if (STACK_TAG == tag) {
     // printf("makeInitialElem stack\n");
 
@@ -55,6 +55,7 @@ void HM_configChunks(GC_state s) {
   assert(isAligned(s->controls->allocChunkSize, s->controls->blockSize));
   HM_BLOCK_SIZE = s->controls->blockSize;
   HM_ALLOC_SIZE = s->controls->allocChunkSize;
+  s->blockMask = ~((uintptr_t)HM_BLOCK_SIZE - 1);
 }
 
 void HM_prependChunk(HM_chunkList list, HM_chunk chunk) {
@@ -345,11 +346,13 @@ void HM_forwardHHObjptrsInChunkList(
       p = advanceToObjectData(s, p);
 
       forwardHHObjptrArgs->containingObject = pointerToObjptr(p, NULL);
+      /* The objptrs of weak objects are handled separately, after
+       * everything else has been forwarded (see LGC_processWeaks). */
       p = foreachObjptrInObject(s,
                                 p,
                                 &predicateClosure,
                                 &forwardHHObjptrClosure,
-                                FALSE);
+                                TRUE);
     }
 
     chunk = chunk->nextChunk;
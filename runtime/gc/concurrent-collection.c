@@ -27,6 +27,70 @@ void GC_updateObjectHeader(
   }
 }
 
+Bool CC_tryHelpCollection(GC_state s) {
+  if (!s->controls->hhConfig.parallelCC)
+    return FALSE;
+
+  bool helped = FALSE;
+  uint32_t me = Proc_processorNumber(s);
+  for (uint32_t i = 1; i < s->numberOfProcs && !helped; i++) {
+    struct CC_parallelJob *job =
+      s->procStates[(me + i) % s->numberOfProcs].ccJob;
+    uint32_t state = __atomic_load_n(&(job->state), __ATOMIC_ACQUIRE);
+    if (!(state & CC_JOB_OPEN))
+      continue;
+
+    // attach; this fails if the job was closed in the meantime
+    if (!__sync_bool_compare_and_swap(&(job->state), state, state + 1))
+      continue;
+
+    uint32_t slot = __sync_fetch_and_add(&(job->nextSlot), 1);
+    if (slot < job->maxParticipants) {
+      LOG(LM_CC_COLLECTION, LL_DEBUG,
+        "helping %s of processor %u",
+        job->unmarking ? "unmark" : "mark",
+        Proc_processorNumber(job->owner));
+
+      ConcurrentCollectArgs args = {
+        .origList = job->args->origList,
+        .repList = job->args->repList,
+        .toHead = job->args->toHead,
+        .fromHead = job->args->fromHead,
+        .bytesSaved = 0,
+        .numObjectsMarked = 0,
+        .job = job,
+        .weaks = job->args->weaks
+      };
+      CC_workList_init(s, &(args.worklist));
+      HH_EBR_enterQuiescentState(s);
+      CC_participate(s, job, slot, &args);
+      HH_EBR_leaveQuiescentState(s);
+      CC_workList_free(s, &(args.worklist));
+
+      s->cumulativeStatistics->numCCsHelped++;
+      s->cumulativeStatistics->bytesMarkedHelpingCC += args.bytesSaved;
+      helped = TRUE;
+    }
+
+    // detach; the owner waits for this before reusing the job
+    __sync_fetch_and_sub(&(job->state), 1);
+  }
+
+  return helped;
+}
+
+Bool CC_anyJobOpen(GC_state s) {
+  if (!s->controls->hhConfig.parallelCC)
+    return FALSE;
+
+  for (uint32_t i = 0; i < s->numberOfProcs; i++) {
+    struct CC_parallelJob *job = s->procStates[i].ccJob;
+    if (__atomic_load_n(&(job->state), __ATOMIC_SEQ_CST) & CC_JOB_OPEN)
+      return TRUE;
+  }
+  return FALSE;
+}
+
 #endif
 
 
@@ -88,14 +152,42 @@ void CC_initStack(GC_state s, ConcurrentPackage cp) {
   cp->rootList = temp;
 }
 
-void CC_addToStack (GC_state s, ConcurrentPackage cp, pointer p) {
+bool CC_addToStack (GC_state s, ConcurrentPackage cp, pointer p) {
   if(cp->rootList==NULL) {
     // Its NULL because we won't collect this heap. so no need to snapshot
-    return;
+    return TRUE;
     // LOG(LM_HH_COLLECTION, LL_FORCE, "Concurrent Stack is not initialised\n");
     // CC_initStack(cp);
   }
-  CC_stack_push(s, cp->rootList, (void*)p);
+  return CC_stack_push(s, cp->rootList, (void*)p);
+}
+
+// The target of a weak is not traced by the collection, so a mutator that
+// gets it out of a weak while the heap of the target is being collected has
+// to shade it, like the write barrier does for an overwritten pointer. Once
+// the root stack is closed, marking is over and an unmarked target is sure
+// to be cleared by CC_clearWeaks, so the weak is cleared right away instead.
+// (The mark has to be read before weaksCleared: unmarking only starts after
+// weaksCleared is set.)
+void CC_weakGetBarrier(GC_state s, pointer w, pointer target) {
+  ConcurrentPackage cp =
+    HM_HH_getConcurrentPack(HM_getLevelHead(HM_getChunkOf(target)));
+  if (NULL == cp)
+    return;
+
+  enum CCState state = __atomic_load_n(&(cp->ccstate), __ATOMIC_SEQ_CST);
+  if ((CC_REG != state && CC_COLLECTING != state)
+      || CC_isPointerMarked(target)
+      || CC_addToStack(s, cp, target))
+  {
+    return;
+  }
+
+  if (!CC_isPointerMarked(target)
+      && !__atomic_load_n(&(cp->weaksCleared), __ATOMIC_SEQ_CST))
+  {
+    tryClearWeak(s, w);
+  }
 }
 
 void CC_clearStack(GC_state s, ConcurrentPackage cp) {
@@ -177,6 +269,22 @@ void markObj(pointer p) {
   // *headerp = header;
 }
 
+// Set (or clear) the mark bit, unless it is already set (cleared). Returns
+// true if this call flipped it. When marking in parallel, this guarantees
+// that each object is traced by exactly one participant.
+bool tryFlipMark(pointer p, bool marked) {
+  GC_header* headerp = getHeaderp(p);
+  while (TRUE) {
+    GC_header header = *headerp;
+    if (((MARK_MASK & header) == MARK_MASK) != marked) {
+      return FALSE;
+    }
+    if (__sync_bool_compare_and_swap(headerp, header, header ^ MARK_MASK)) {
+      return TRUE;
+    }
+  }
+}
+
 // This function is exactly the same as in chunk.c.
 // The only difference is, it doesn't NULL the levelHead of the unlinking chunk.
 // TODO: replace with HM_unlinkChunkPreserveLevelHead (see chunk.c)
@@ -218,7 +326,7 @@ void saveChunk(HM_chunk chunk, ConcurrentCollectArgs* args) {
 }
 
 bool saveNoForward(
-  __attribute__((unused)) GC_state s,
+  GC_state s,
   pointer p,
   void* rawArgs)
 {
@@ -228,7 +336,15 @@ bool saveNoForward(
   bool chunkSaved = isChunkInToSpace(cand_chunk, args);
   bool chunkOrig  = (chunkSaved)?TRUE:isChunkInFromSpace(cand_chunk, args);
 
-  if(chunkOrig && !chunkSaved) {
+  if(chunkOrig && !chunkSaved && NULL != args->job) {
+    // another participant might be saving the same chunk
+    spinlock_lock(&(args->job->lock), Proc_processorNumber(s));
+    if (isChunkInFromSpace(cand_chunk, args)) {
+      saveChunk(cand_chunk, args);
+    }
+    spinlock_unlock(&(args->job->lock));
+  }
+  else if(chunkOrig && !chunkSaved) {
     assert(isChunkInFromSpace(cand_chunk, args));
     assert(getTransitivePtr(p, rawArgs) == p);
     saveChunk(cand_chunk, args);
@@ -307,6 +423,116 @@ bool isChunkInList(HM_chunk chunk, HM_chunkList list) {
   return FALSE;
 }
 
+// Objects handed to the shared pool whenever it holds fewer than this many.
+#define CC_POOL_LOW_WATER 64
+// Maximum number of objects taken from the pool at once.
+#define CC_GRAIN_BATCH 16
+
+// Requires that the job is closed, or that the caller holds the lock.
+static void pushGrain(struct CC_parallelJob* job, objptr op) {
+  if (job->poolSize == job->poolCapacity) {
+    size_t newCapacity = (0 == job->poolCapacity) ? 256 : 2 * job->poolCapacity;
+    objptr* newPool = (objptr*)realloc(job->pool, newCapacity * sizeof(objptr));
+    if (NULL == newPool) {
+      DIE("Ran out of space for concurrent collection work pool!");
+    }
+    job->pool = newPool;
+    job->poolCapacity = newCapacity;
+  }
+  job->pool[job->poolSize] = op;
+  job->poolSize++;
+}
+
+// Add a freshly (un)marked object to be traced. If helpers are attached and
+// running low on work, it goes into the shared pool instead of our own work
+// list.
+static void pushWork(GC_state s, ConcurrentCollectArgs* args, objptr op) {
+  struct CC_parallelJob* job = args->job;
+  if (NULL != job
+      && 0 != (__atomic_load_n(&(job->state), __ATOMIC_RELAXED) & ~CC_JOB_OPEN)
+      && __atomic_load_n(&(job->poolSize), __ATOMIC_RELAXED) < CC_POOL_LOW_WATER)
+  {
+    spinlock_lock(&(job->lock), Proc_processorNumber(s));
+    pushGrain(job, op);
+    spinlock_unlock(&(job->lock));
+    return;
+  }
+  CC_workList_push(s, &(args->worklist), op);
+}
+
+// Take up to CC_GRAIN_BATCH objects from the pool, waiting if necessary.
+// Returns 0 once the pool is empty and nobody is active anymore, at which
+// point no more work can appear. Otherwise, the caller is counted as active
+// until it decrements job->numActive.
+static size_t takeGrains(GC_state s, struct CC_parallelJob* job, objptr* result) {
+  while (TRUE) {
+    spinlock_lock(&(job->lock), Proc_processorNumber(s));
+    if (job->poolSize > 0) {
+      size_t n = min(job->poolSize, (size_t)CC_GRAIN_BATCH);
+      job->poolSize -= n;
+      memcpy(result, &(job->pool[job->poolSize]), n * sizeof(objptr));
+      __sync_fetch_and_add(&(job->numActive), 1);
+      spinlock_unlock(&(job->lock));
+      return n;
+    }
+    bool done = (0 == __atomic_load_n(&(job->numActive), __ATOMIC_ACQUIRE));
+    spinlock_unlock(&(job->lock));
+
+    if (done)
+      return 0;
+
+    while (0 == __atomic_load_n(&(job->poolSize), __ATOMIC_ACQUIRE) &&
+           0 != __atomic_load_n(&(job->numActive), __ATOMIC_ACQUIRE))
+    {
+      /* spin */
+    }
+  }
+}
+
+static void recordWeak(GC_state s, ConcurrentCollectArgs* args, objptr op) {
+  if (NULL != args->job)
+    spinlock_lock(&(args->job->lock), Proc_processorNumber(s));
+  HM_storeInChunkList(args->weaks, &op, sizeof(objptr));
+  if (NULL != args->job)
+    spinlock_unlock(&(args->job->lock));
+}
+
+// Weak objects are marked like any other object, but their targets are not
+// traced (see makeInitialElem). Once marking is over, this clears every
+// marked weak whose target is in scope but was not marked, before the
+// unmarking pass erases that information.
+static void CC_clearWeaks(GC_state s, ConcurrentCollectArgs* args) {
+  size_t numCleared = 0;
+
+  for (HM_chunk chunk = HM_getChunkListFirstChunk(args->weaks);
+       NULL != chunk;
+       chunk = chunk->nextChunk)
+  {
+    for (pointer cursor = HM_getChunkStart(chunk);
+         cursor < HM_getChunkFrontier(chunk);
+         cursor += sizeof(objptr))
+    {
+      pointer w = objptrToPointer(*((objptr*)cursor), NULL);
+      objptr op = ((GC_weak)(w + offsetofWeak(s)))->objptr;
+      if (isWeakGone(getHeader(w)) || !isObjptr(op))
+        continue;
+
+      pointer p = objptrToPointer(op, NULL);
+      HM_chunk opChunk = HM_getChunkOf(p);
+      if (!isChunkInFromSpace(opChunk, args) && !isChunkInToSpace(opChunk, args))
+        continue;
+
+      if (!CC_isPointerMarked(p) && tryClearWeak(s, w))
+        numCleared++;
+    }
+  }
+
+  if (numCleared > 0) {
+    LOG(LM_CC_COLLECTION, LL_DEBUG, "weaks: %zu cleared", numCleared);
+  }
+  s->cumulativeStatistics->numWeaksCleared += numCleared;
+}
+
 void tryMarkAndAddToWorkList(
   GC_state s,
   __attribute__((unused)) objptr *opp,
@@ -322,12 +548,15 @@ void tryMarkAndAddToWorkList(
   if (!isInScope)
     return;
 
-  if (!CC_isPointerMarked(p)) {
-    markObj(p);
+  if (tryFlipMark(p, FALSE)) {
     args->bytesSaved += sizeofObject(s, p);
     args->numObjectsMarked++;
     assert(CC_isPointerMarked(p));
-    CC_workList_push(s, &(args->worklist), op);
+    GC_objectTypeTag tag;
+    splitHeader(s, getHeader(p), &tag, NULL, NULL, NULL);
+    if (WEAK_TAG == tag)
+      recordWeak(s, args, op);
+    pushWork(s, args, op);
   }
 }
 
@@ -346,11 +575,10 @@ void tryUnmarkAndAddToWorkList(
     return;
   }
 
-  if (CC_isPointerMarked(p)) {
+  if (tryFlipMark(p, TRUE)) {
     assert(isChunkInToSpace(chunk, args));
-    markObj(p);
     assert(!CC_isPointerMarked(p));
-    CC_workList_push(s, &(args->worklist), op);
+    pushWork(s, args, op);
   }
 }
 
@@ -384,14 +612,147 @@ void unmarkLoop(GC_state s, ConcurrentCollectArgs* args) {
   assert(CC_workList_isEmpty(s, worklist));
 }
 
-void tryMarkAndMarkLoop(GC_state s, objptr *opp, objptr op, void* rawArgs) {
-  tryMarkAndAddToWorkList(s, opp, op, rawArgs);
-  markLoop(s, rawArgs);
+void CC_participate(
+  GC_state s,
+  struct CC_parallelJob* job,
+  uint32_t slot,
+  ConcurrentCollectArgs* args)
+{
+  assert(slot < job->maxParticipants);
+  assert(args->job == job);
+
+  struct CC_participantStats* stats = &(job->stats[slot]);
+  struct timespec startTime;
+  struct timespec stopTime;
+  objptr grains[CC_GRAIN_BATCH];
+
+  // the collector starts out active, with its own work list full of roots
+  bool haveWork = (0 == slot);
+  while (TRUE) {
+    size_t n = 0;
+    if (!haveWork && 0 == (n = takeGrains(s, job, grains)))
+      break;
+    haveWork = FALSE;
+
+    timespec_now(&startTime);
+    for (size_t i = 0; i < n; i++) {
+      CC_workList_push(s, &(args->worklist), grains[i]);
+    }
+    if (job->unmarking)
+      unmarkLoop(s, args);
+    else
+      markLoop(s, args);
+    timespec_now(&stopTime);
+    timespec_sub(&stopTime, &startTime);
+    timespec_add(&(stats->timeBusy), &stopTime);
+    __sync_fetch_and_sub(&(job->numActive), 1);
+  }
+
+  stats->bytesSaved = args->bytesSaved;
+  stats->numObjectsMarked = args->numObjectsMarked;
+}
+
+struct CC_parallelJob* CC_newParallelJob(void) {
+  struct CC_parallelJob* job =
+    (struct CC_parallelJob*)malloc_safe(sizeof(struct CC_parallelJob));
+  job->state = 0;
+  spinlock_init(&(job->lock));
+  job->owner = NULL;
+  job->args = NULL;
+  job->unmarking = FALSE;
+  job->maxParticipants = 0;
+  job->nextSlot = 0;
+  job->numActive = 0;
+  job->pool = NULL;
+  job->poolSize = 0;
+  job->poolCapacity = 0;
+  job->stats = NULL;
+  return job;
 }
 
-void tryUnmarkAndUnmarkLoop(GC_state s, objptr *opp, objptr op, void* rawArgs) {
-  tryUnmarkAndAddToWorkList(s, opp, op, rawArgs);
-  unmarkLoop(s, rawArgs);
+// Summary of the parallelism achieved by one collection.
+struct CC_parallelSummary {
+  uint32_t maxParticipants;
+  struct timespec timeWall;
+  struct timespec timeWork;
+};
+
+// Drain the work list, with the help of any idle processors that join in if
+// `summary` is non-NULL. See struct CC_parallelJob.
+void traceLoop(
+  GC_state s,
+  ConcurrentCollectArgs* args,
+  bool unmarking,
+  struct CC_parallelSummary* summary)
+{
+  if (NULL == summary) {
+    if (unmarking)
+      unmarkLoop(s, args);
+    else
+      markLoop(s, args);
+    return;
+  }
+
+  struct CC_parallelJob* job = s->ccJob;
+  assert(0 == job->state);
+  assert(NULL == args->job);
+  assert(NULL != job->stats);
+
+  struct timespec startTime;
+  struct timespec stopTime;
+  timespec_now(&startTime);
+
+  job->poolSize = 0;
+  for (uint32_t i = 0; i < job->maxParticipants; i++) {
+    job->stats[i].bytesSaved = 0;
+    job->stats[i].numObjectsMarked = 0;
+    job->stats[i].timeBusy.tv_sec = 0;
+    job->stats[i].timeBusy.tv_nsec = 0;
+  }
+
+  // the collector's own counts are already in args, so start from zero
+  size_t bytesSaved = args->bytesSaved;
+  size_t numObjectsMarked = args->numObjectsMarked;
+  args->bytesSaved = 0;
+  args->numObjectsMarked = 0;
+  args->job = job;
+
+  job->owner = s;
+  job->args = args;
+  job->unmarking = unmarking;
+  job->numActive = 1;
+  job->nextSlot = 1;
+  __atomic_store_n(&(job->state), CC_JOB_OPEN, __ATOMIC_SEQ_CST);
+  // seq-cst store: pairs with the check in the scheduler's park, so either
+  // the parking worker sees the job or we see it as a sleeper and wake it
+  Parallel_idleWakeOne();
+
+  CC_participate(s, job, 0, args);
+
+  // close the job and wait for the helpers to detach
+  __sync_fetch_and_and(&(job->state), ~CC_JOB_OPEN);
+  while (0 != __atomic_load_n(&(job->state), __ATOMIC_ACQUIRE)) {
+    /* spin */
+  }
+  assert(0 == job->poolSize);
+  assert(0 == job->numActive);
+  args->job = NULL;
+
+  uint32_t numParticipants = min(job->nextSlot, job->maxParticipants);
+  for (uint32_t i = 0; i < numParticipants; i++) {
+    bytesSaved += job->stats[i].bytesSaved;
+    numObjectsMarked += job->stats[i].numObjectsMarked;
+    timespec_add(&(summary->timeWork), &(job->stats[i].timeBusy));
+  }
+  args->bytesSaved = bytesSaved;
+  args->numObjectsMarked = numObjectsMarked;
+
+  summary->maxParticipants = max(summary->maxParticipants, numParticipants);
+  s->cumulativeStatistics->numCCHelpers += numParticipants - 1;
+
+  timespec_now(&stopTime);
+  timespec_sub(&stopTime, &startTime);
+  timespec_add(&(summary->timeWall), &stopTime);
 }
 
 #if 0
@@ -416,9 +777,9 @@ void forwardPtrChunk (GC_state s, objptr *opp, void* rawArgs) {
 
 void forwardPinned(GC_state s, HM_remembered remElem, void* rawArgs) {
   objptr src = remElem->object;
-  tryMarkAndMarkLoop(s, &src, src, rawArgs);
+  tryMarkAndAddToWorkList(s, &src, src, rawArgs);
   if (remElem->from != BOGUS_OBJPTR) {
-    tryMarkAndMarkLoop(s, &(remElem->from), remElem->from, rawArgs);
+    tryMarkAndAddToWorkList(s, &(remElem->from), remElem->from, rawArgs);
   }
 
 #if 0
@@ -499,9 +860,9 @@ void unmarkPinned(
 {
   objptr src = remElem->object;
   assert(!(HM_getChunkOf(objptrToPointer(src, NULL))->pinnedDuringCollection));
-  tryUnmarkAndUnmarkLoop(s, &src, src, rawArgs);
+  tryUnmarkAndAddToWorkList(s, &src, src, rawArgs);
   if (remElem->from != BOGUS_OBJPTR) {
-    tryUnmarkAndUnmarkLoop(s, &(remElem->from), remElem->from, rawArgs);
+    tryUnmarkAndAddToWorkList(s, &(remElem->from), remElem->from, rawArgs);
   }
   // unmarkPtrChunk(s, &src, rawArgs);
   // unmarkPtrChunk(s, &(remElem->from), rawArgs);
@@ -526,7 +887,8 @@ void unmarkPinned(
 
 // This function does more than forwardPtrChunk.
 // It scans the object pointed by the pointer even if its not in scope.
-// Recursively however it only calls forwardPtrChunk and not itself
+// Recursively however it only calls forwardPtrChunk and not itself.
+// The object is only added to the work list; the caller drains it.
 void forceForward(GC_state s, objptr *opp, void* rawArgs) {
   ConcurrentCollectArgs *args = (ConcurrentCollectArgs*)rawArgs;
   objptr op = *opp;
@@ -549,7 +911,6 @@ void forceForward(GC_state s, objptr *opp, void* rawArgs) {
   }
 
   CC_workList_push(s, &(args->worklist), op);
-  markLoop(s, rawArgs);
 }
 
 void forceUnmark (GC_state s, objptr* opp, void* rawArgs) {
@@ -570,7 +931,6 @@ void forceUnmark (GC_state s, objptr* opp, void* rawArgs) {
   }
 
   CC_workList_push(s, &(args->worklist), op);
-  unmarkLoop(s, rawArgs);
 }
 
 void ensureCallSanity(
@@ -966,9 +1326,34 @@ void CC_collectWithRoots(
     .toHead = (void*)repList,
     .fromHead = (void*) &(origList),
     .bytesSaved = 0,
-    .numObjectsMarked = 0
+    .numObjectsMarked = 0,
+    .job = NULL,
+    .weaks = NULL
   };
   CC_workList_init(s, &(lists.worklist));
+  struct HM_chunkList weaks;
+  HM_initChunkList(&weaks);
+  lists.weaks = &weaks;
+
+  // Only worth inviting helpers if there is a decent amount of work.
+  struct CC_parallelJob *job = s->ccJob;
+  struct CC_parallelSummary _summary =
+    {.maxParticipants = 1,
+     .timeWall = {.tv_sec = 0, .tv_nsec = 0},
+     .timeWork = {.tv_sec = 0, .tv_nsec = 0}};
+  struct CC_parallelSummary *summary = NULL;
+  if (s->controls->hhConfig.parallelCC &&
+      s->numberOfProcs > 1 &&
+      s->controls->hhConfig.maxCCHelpers > 0 &&
+      HM_getChunkListSize(origList) >= s->controls->hhConfig.minParallelCCSize)
+  {
+    summary = &_summary;
+    job->maxParticipants =
+      min(s->numberOfProcs, s->controls->hhConfig.maxCCHelpers + 1);
+    job->stats = (struct CC_participantStats *)
+      malloc_safe(job->maxParticipants * sizeof(struct CC_participantStats));
+    s->cumulativeStatistics->numParallelCCs++;
+  }
 
   HH_EBR_enterQuiescentState(s);
 
@@ -1014,7 +1399,7 @@ void CC_collectWithRoots(
   forceForward(s, &(cp->stack), &lists);
   forceForward(s, &(cp->additionalStack), &lists);
 
-  markLoop(s, &lists);
+  traceLoop(s, &lists, FALSE, summary);
 
   // JATIN_NOTE: This is important because the stack object of the thread we are collecting
   // often changes the level it is at. So it might in fact be at depth = 1.
@@ -1034,17 +1419,22 @@ void CC_collectWithRoots(
     forEachObjptrInCCStackBag(
       s,
       tempRemovedFromCCBag,
-      tryMarkAndMarkLoop,
+      tryMarkAndAddToWorkList,
       &lists);
     HM_appendChunkList(removedFromCCBag, tempRemovedFromCCBag);
     HM_initChunkList(tempRemovedFromCCBag);
 
-    markLoop(s, &lists);
+    traceLoop(s, &lists, FALSE, summary);
   }
 
   assert(CC_workList_isEmpty(s, &(lists.worklist)));
   assert(NULL == tempRemovedFromCCBag->firstChunk);
 
+  CC_clearWeaks(s, &lists);
+  HM_freeChunksInList(s, &weaks);
+  lists.weaks = NULL;
+  __atomic_store_n(&(cp->weaksCleared), TRUE, __ATOMIC_SEQ_CST);
+
   // saveNoForward(s, (void*)(thread->stack), &lists);
   // saveNoForward(s, (void*)thread, &lists);
 
@@ -1074,11 +1464,29 @@ void CC_collectWithRoots(
   forceUnmark(s, &(cp->stack), &lists);
   forceUnmark(s, &(cp->additionalStack), &lists);
 
-  unmarkLoop(s, &lists);
-
   // forEachObjptrinStack(s, cp->rootList, unmarkPtrChunk, &lists);
-  forEachObjptrInCCStackBag(s, removedFromCCBag, tryUnmarkAndUnmarkLoop, &lists);
-  unmarkLoop(s, &lists);
+  forEachObjptrInCCStackBag(s, removedFromCCBag, tryUnmarkAndAddToWorkList, &lists);
+  traceLoop(s, &lists, TRUE, summary);
+
+  if (NULL != summary) {
+    free(job->stats);
+    job->stats = NULL;
+
+    double wall =
+      (double)summary->timeWall.tv_sec + (double)summary->timeWall.tv_nsec / 1e9;
+    double work =
+      (double)summary->timeWork.tv_sec + (double)summary->timeWork.tv_nsec / 1e9;
+    LOG(LM_CC_COLLECTION, LL_INFO,
+      "parallel marking at depth %u: up to %u participants, %.3lfs of work in %.3lfs (%.2lfx)",
+      initialDepth,
+      summary->maxParticipants,
+      work,
+      wall,
+      (0.0 == wall) ? 1.0 : work / wall);
+
+    timespec_add(&(s->cumulativeStatistics->timeCCParallelMark), &(summary->timeWall));
+    timespec_add(&(s->cumulativeStatistics->timeCCParallelWork), &(summary->timeWork));
+  }
 
   HM_freeChunksInListWithInfo(s, removedFromCCBag, NULL, BLOCK_FOR_FORGOTTEN_SET);
 
@@ -1203,6 +1611,10 @@ void CC_collectWithRoots(
     cp->additionalStack = BOGUS_OBJPTR;
   }
 
+  /* Most of the chunks of a heap collected concurrently were allocated by
+   * other processors; don't keep them waiting for their blocks. */
+  publishRemoteFrees(s);
+
 // #if ASSERT
 //   struct HM_foreachDownptrClosure checkRemEntryClosure =
 //     {.fun = checkRemEntry, .env = &lists};
@@ -20,6 +20,8 @@
 
 #if (defined (MLTON_GC_INTERNAL_TYPES))
 
+struct CC_parallelJob;
+
 // Struct to pass around args. repList is the new chunklist.
 typedef struct ConcurrentCollectArgs {
   struct CC_workList worklist;
@@ -29,8 +31,53 @@ typedef struct ConcurrentCollectArgs {
   void* fromHead;
   size_t bytesSaved;
 	size_t numObjectsMarked;
+  // non-NULL while marking or unmarking together with helpers
+  struct CC_parallelJob* job;
+  // the weak objects marked so far (see CC_clearWeaks); shared by all
+  // participants, under job->lock
+  HM_chunkList weaks;
 } ConcurrentCollectArgs;
 
+struct CC_participantStats {
+  size_t bytesSaved;
+  size_t numObjectsMarked;
+  struct timespec timeBusy;
+};
+
+// Every processor owns one of these (s->ccJob), used to invite idle
+// processors to help with the mark and unmark loops of its concurrent
+// collections. Each participant traces with its own work list. Whenever the
+// shared pool runs low, newly (un)marked objects are handed to the pool
+// instead, where any participant can pick them up. Marks are set with a CAS
+// so that exactly one participant traces each object, and chunks are moved
+// from origList to repList under the job lock. The loop is over once the
+// pool is empty and no participant is active.
+//
+// The job itself is never freed, so a helper can always safely inspect the
+// state of another processor's job.
+struct CC_parallelJob {
+  // CC_JOB_OPEN bit, plus the number of helpers currently attached
+  volatile uint32_t state;
+
+  // protects the pool, and also saveChunk
+  spinlock_t lock;
+
+  GC_state owner;                     // the collecting processor
+  ConcurrentCollectArgs* args;        // the collector's arguments
+  bool unmarking;                     // which loop is being run
+  uint32_t maxParticipants;           // including the collector (slot 0)
+  volatile uint32_t nextSlot;
+  volatile uint32_t numActive;
+
+  objptr* pool;
+  volatile size_t poolSize;
+  size_t poolCapacity;
+
+  struct CC_participantStats* stats;
+};
+
+#define CC_JOB_OPEN ((uint32_t)1 << 31)
+
 
 enum CCState{
   CC_UNREG,
@@ -53,6 +100,9 @@ typedef struct ConcurrentPackage {
   enum CCState ccstate;
   objptr stack;
   objptr additionalStack;
+  // set once the weaks of this collection have been cleared (see
+  // CC_weakGetBarrier)
+  bool weaksCleared;
 
   /** For deciding when to collect. Could be cleaned up.
     */
@@ -78,6 +128,15 @@ typedef struct ConcurrentPackage *ConcurrentPackage;
 
 PRIVATE void GC_updateObjectHeader(GC_state s, pointer p, GC_header newHeader);
 
+// Called by idle processors. If some other processor is currently marking
+// or unmarking for a parallel concurrent collection, join it as a helper.
+// Returns true if any help was given.
+PRIVATE Bool CC_tryHelpCollection(GC_state s);
+
+// True if some processor currently has a parallel concurrent collection
+// job open for helpers.
+PRIVATE Bool CC_anyJobOpen(GC_state s);
+
 #endif
 
 
@@ -99,13 +158,23 @@ void CC_collectWithRoots(
 	size_t *numObjectsMarked);
 	
 void CC_collectAtPublicLevel(GC_state s, GC_thread thread, uint32_t depth);
-void CC_addToStack(GC_state s, ConcurrentPackage cp, pointer p);
+// Returns false if the collection no longer accepts roots.
+bool CC_addToStack(GC_state s, ConcurrentPackage cp, pointer p);
+// Called by GC_weakGet on the target of a weak that has not been cleared.
+void CC_weakGetBarrier(GC_state s, pointer w, pointer target);
 void CC_initStack(GC_state s, ConcurrentPackage cp);
 
 
 bool CC_isPointerMarked (pointer p);
 void printObjPtrFunction(GC_state s, objptr* opp, void* rawArgs);
 void CC_clearMutationStack(ConcurrentPackage cp);
+
+struct CC_parallelJob* CC_newParallelJob(void);
+void CC_participate(
+  GC_state s,
+  struct CC_parallelJob* job,
+  uint32_t slot,
+  ConcurrentCollectArgs* args);
 #endif
 
 #endif
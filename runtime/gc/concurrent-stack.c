@@ -21,8 +21,42 @@ void CC_stack_init(GC_state s, CC_stack* stack) {
     // stack->stacks[i].capacity = capacity;
     // stack->stacks[i].storage = NULL;
     HM_initChunkList(&(stack->stacks[i].storage));
-    stack->stacks[i].isClosed = FALSE;
-    pthread_mutex_init(&(stack->stacks[i].mutex), NULL);
+    stack->stacks[i].published = NULL;
+    stack->stacks[i].state = CC_STACK_OPEN;
+    stack->stacks[i].pushing = 0;
+  }
+}
+
+// Hand a full chunk over to the collector. Only the owner publishes, and
+// the collector only ever takes the whole list, so there is no ABA problem.
+static void publishChunk(CC_stack_data* stack, HM_chunk chunk) {
+  HM_chunk head = __atomic_load_n(&(stack->published), __ATOMIC_RELAXED);
+  do {
+    chunk->nextChunk = head;
+  } while (!__atomic_compare_exchange_n(&(stack->published), &head, chunk,
+             TRUE, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+// Move all published chunks into `removed`. Returns true if there were any.
+static bool takePublished(CC_stack_data* stack, HM_chunkList removed) {
+  HM_chunk chunk = __atomic_exchange_n(&(stack->published), NULL, __ATOMIC_ACQUIRE);
+  bool tookAny = (NULL != chunk);
+  while (NULL != chunk) {
+    HM_chunk next = chunk->nextChunk;
+    chunk->nextChunk = NULL;
+    HM_appendChunk(removed, chunk);
+    chunk = next;
+  }
+  return tookAny;
+}
+
+// Stop the owner from pushing, and wait for any push in progress. Afterwards,
+// the collector has exclusive access to stack->storage until it resets the
+// state.
+static void startDraining(CC_stack_data* stack) {
+  __atomic_store_n(&(stack->state), CC_STACK_DRAINING, __ATOMIC_SEQ_CST);
+  while (0 != __atomic_load_n(&(stack->pushing), __ATOMIC_SEQ_CST)) {
+    /* spin */
   }
 }
 
@@ -46,12 +80,23 @@ bool increaseCapacity(CC_stack_data* stack, int factor){
 
 // return false if the push failed. true if push succeeds
 bool CC_stack_data_push(CC_stack_data* stack, void* datum){
-    pthread_mutex_lock(&stack->mutex);
-
-
-    if (stack->isClosed) {
-        pthread_mutex_unlock(&stack->mutex);
-        return FALSE;
+    while (TRUE) {
+        // pairs with startDraining: either we see DRAINING, or the
+        // collector waits for us to finish
+        __atomic_store_n(&(stack->pushing), 1, __ATOMIC_SEQ_CST);
+        uint32_t state = __atomic_load_n(&(stack->state), __ATOMIC_SEQ_CST);
+        if (CC_STACK_OPEN == state)
+            break;
+
+        __atomic_store_n(&(stack->pushing), 0, __ATOMIC_RELEASE);
+        if (CC_STACK_CLOSED == state)
+            return FALSE;
+
+        // the collector is briefly looking at our last chunk
+        while (CC_STACK_DRAINING ==
+               __atomic_load_n(&(stack->state), __ATOMIC_ACQUIRE)) {
+            /* spin */
+        }
     }
 
 
@@ -71,8 +116,16 @@ bool CC_stack_data_push(CC_stack_data* stack, void* datum){
     stack->storage[stack->size++] = datum;
 #endif
 
-    HM_storeInChunkListWithPurpose(&(stack->storage), &(datum), sizeof(datum), BLOCK_FOR_FORGOTTEN_SET);
-    pthread_mutex_unlock(&stack->mutex);
+    HM_chunkList storage = &(stack->storage);
+    HM_chunk last = HM_getChunkListLastChunk(storage);
+    HM_storeInChunkListWithPurpose(storage, &(datum), sizeof(datum), BLOCK_FOR_FORGOTTEN_SET);
+    if (NULL != last && last != HM_getChunkListLastChunk(storage)) {
+        // no room was left in `last`, so the collector can have it
+        HM_unlinkChunk(storage, last);
+        publishChunk(stack, last);
+    }
+
+    __atomic_store_n(&(stack->pushing), 0, __ATOMIC_RELEASE);
     return TRUE;
 }
 
@@ -141,6 +194,7 @@ void CC_stack_data_free(CC_stack_data* stack){
 #endif
 
 void CC_stack_data_free(GC_state s, CC_stack_data* stack) {
+  takePublished(stack, &(stack->storage));
   HM_freeChunksInListWithInfo(s, &(stack->storage), NULL, BLOCK_FOR_FORGOTTEN_SET);
 }
 
@@ -153,9 +207,16 @@ void CC_stack_free(GC_state s, CC_stack* stack) {
 }
 
 void CC_stack_data_clear(GC_state s, CC_stack_data* stack){
-    pthread_mutex_lock(&stack->mutex);
+    // once closed, nobody touches the storage anymore
+    bool open = (CC_STACK_OPEN == __atomic_load_n(&(stack->state), __ATOMIC_ACQUIRE));
+    if (open)
+        startDraining(stack);
+
+    takePublished(stack, &(stack->storage));
     HM_freeChunksInListWithInfo(s, &(stack->storage), NULL, BLOCK_FOR_FORGOTTEN_SET);
-    pthread_mutex_unlock(&stack->mutex);
+
+    if (open)
+        __atomic_store_n(&(stack->state), CC_STACK_OPEN, __ATOMIC_RELEASE);
 }
 
 
@@ -177,64 +238,50 @@ void CC_stack_clear(GC_state s, CC_stack* stack) {
 
 bool CC_stack_try_close(CC_stack* stack, HM_chunkList removed) {
 
-  // First, do a quick check to avoid taking locks unnecessarily
-  bool allEmpty = TRUE;
+  // First, take the full chunks that have been handed off. This doesn't
+  // interfere with pushes at all.
+  bool tookAny = FALSE;
   for (size_t i = 0; i < stack->numStacks; i++) {
-    HM_chunkList thisBag = &(stack->stacks[i].storage);
-    if (NULL != thisBag->firstChunk) {
-      allEmpty = FALSE;
-      break;
-    }
+    tookAny = takePublished(&(stack->stacks[i]), removed) || tookAny;
+  }
+  if (tookAny) {
+    return FALSE;
   }
 
-  /** We checked that all are empty; now just have to confirm and close. This
-    * works by taking all the locks, verying that each is empty, and closing
-    * it. If any has been extended in the meantime, we have to abort.
+  /** Looks like all are empty; now just have to confirm and close. This
+    * works by stopping all pushes, verifying that each bag is empty, and
+    * closing it. If any has been extended in the meantime, we take its
+    * elements and reopen everything instead.
     */
-  if (allEmpty) {
-    size_t i;
-    for (i = 0; i < stack->numStacks; i++) {
-      pthread_mutex_lock(&(stack->stacks[i].mutex));
-      HM_chunkList thisBag = &(stack->stacks[i].storage);
-      if (NULL != thisBag->firstChunk)
-        break;
-      stack->stacks[i].isClosed = TRUE;
-    }
+  for (size_t i = 0; i < stack->numStacks; i++) {
+    startDraining(&(stack->stacks[i]));
+  }
 
-    if (i == stack->numStacks) {
-      // success! unlock everything and return.
-      stack->allClosed = TRUE;
-      for (size_t j = 0; j < i; j++) {
-        pthread_mutex_unlock(&(stack->stacks[j].mutex));
-      }
-      return TRUE;
+  bool allEmpty = TRUE;
+  for (size_t i = 0; i < stack->numStacks; i++) {
+    CC_stack_data* thisStack = &(stack->stacks[i]);
+    HM_chunkList thisBag = &(thisStack->storage);
+    if (takePublished(thisStack, removed)) {
+      allEmpty = FALSE;
     }
-
-    // Otherwise, we failed to close. Unlock everything before continuing.
-    for (size_t j = 0; j < i; j++) {
-      pthread_mutex_unlock(&(stack->stacks[j].mutex));
+    // the owner only keeps a chunk around after storing something in it
+    if (NULL != HM_getChunkListFirstChunk(thisBag)) {
+      allEmpty = FALSE;
+      HM_appendChunkList(removed, thisBag);
+      HM_initChunkList(thisBag);
     }
   }
 
+  if (allEmpty) {
+    stack->allClosed = TRUE;
+  }
 
-  /** If we reach here, then there is at least one bag which is non-empty,
-    * and we're currently holding no locks. Proceed by taking a batch of
-    * elements and returning them.
-    */
-
+  uint32_t newState = allEmpty ? CC_STACK_CLOSED : CC_STACK_OPEN;
   for (size_t i = 0; i < stack->numStacks; i++) {
-    HM_chunkList thisBag = &(stack->stacks[i].storage);
-    if (NULL != HM_getChunkListFirstChunk(thisBag)) {
-      pthread_mutex_lock(&(stack->stacks[i].mutex));
-      HM_chunk chunk = HM_getChunkListFirstChunk(thisBag);
-      HM_unlinkChunk(thisBag, chunk);
-      pthread_mutex_unlock(&(stack->stacks[i].mutex));
-
-      HM_appendChunk(removed, chunk);
-    }
+    __atomic_store_n(&(stack->stacks[i].state), newState, __ATOMIC_RELEASE);
   }
 
-  return FALSE;
+  return allEmpty;
 }
 
 
@@ -304,6 +351,7 @@ void forEachObjptrInCCStackBag(
 }
 
 
+#if 0
 void forEachObjptrInStackData(
   GC_state s,
   CC_stack_data* stack,
@@ -345,6 +393,6 @@ void forEachObjptrinStack(
     forEachObjptrInStackData(s, &(stack->stacks[i]), f, rawArgs);
   }
 }
-
 #endif
 
+#endif
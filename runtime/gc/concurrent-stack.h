@@ -3,12 +3,28 @@
 
 #if (defined (MLTON_GC_INTERNAL_TYPES))
 
+/* One of these per processor. Only the owning processor pushes, and only
+ * the collector takes elements out, so neither side needs a lock:
+ *   - The owner appends to `storage`. Whenever a chunk fills up, it is
+ *     published by CAS onto `published`, which the collector takes in one
+ *     atomic exchange.
+ *   - To look at the partially filled last chunk, or to close the stack,
+ *     the collector sets `state` to CC_STACK_DRAINING and waits for any
+ *     push in progress (`pushing`) to finish. The owner waits for
+ *     CC_STACK_DRAINING to pass, so pushes never fail until the stack is
+ *     actually closed.
+ */
 typedef struct CC_stack_data {
     struct HM_chunkList storage;
-    bool isClosed;
-    pthread_mutex_t mutex;
+    HM_chunk published;  // linked through nextChunk
+    volatile uint32_t state;
+    volatile uint32_t pushing;
 } CC_stack_data;
 
+#define CC_STACK_OPEN 0
+#define CC_STACK_DRAINING 1
+#define CC_STACK_CLOSED 2
+
 typedef struct CC_stack {
   bool allClosed;
   size_t numStacks;
@@ -17,3 +17,11 @@ bool needGCTime (GC_state s) {
     or s->controls->messages
     or s->controls->rusageMeasureGC;
 }
+
+void initOverheadPolicy (struct GC_overheadPolicy *policy) {
+  policy->collectionThresholdRatio = 0.0;
+  policy->windowStart.tv_sec = 0;
+  policy->windowStart.tv_nsec = 0;
+  policy->windowGCTime.tv_sec = 0;
+  policy->windowGCTime.tv_nsec = 0;
+}
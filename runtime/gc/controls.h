@@ -27,6 +27,11 @@ struct HM_HierarchicalHeapConfig {
    * crosses this threshold, a local collection may be triggered. */
   double collectionThresholdRatio;
 
+  /* if nonzero, collectionThresholdRatio is only the starting point: each
+   * processor adapts its own ratio so that roughly this fraction of its time
+   * is spent in local and concurrent collections. */
+  double targetGCOverhead;
+
   /* the smallest amount of allocated data that can be collected in a
    * local collection */
   size_t minCollectionSize;
@@ -41,6 +46,30 @@ struct HM_HierarchicalHeapConfig {
   /* the shallowest depth that will be claimed for a local
    * collection. */
   uint32_t minLocalDepth;
+
+  /* whether idle processors may help with local collections, and the
+   * smallest scope (in bytes) for which helpers are invited */
+  bool parallelLocalCollection;
+  size_t minParallelLocalCollectionSize;
+  uint32_t maxLocalCollectionHelpers;
+
+  /* likewise for the marking phases of concurrent collections */
+  bool parallelCC;
+  size_t minParallelCCSize;
+  uint32_t maxCCHelpers;
+};
+
+/**
+ * Per-processor state of the gc-overhead collection policy (see
+ * HM_HH_adjustCollectionThreshold), which adapts
+ * hhConfig.collectionThresholdRatio when targetGCOverhead is set.
+ */
+struct GC_overheadPolicy {
+  /* ratio currently in use; 0 until the first adjustment */
+  double collectionThresholdRatio;
+  /* wall-clock and GC time at the start of the current window */
+  struct timespec windowStart;
+  struct timespec windowGCTime;
 };
 
 enum GC_CollectionType {
@@ -55,6 +84,17 @@ enum SummaryFormat {
   JSON
 };
 
+enum HeartbeatMode {
+  HEARTBEAT_SIGNAL, /* heartbeats arrive as SIGALRM/SIGUSR1 */
+  HEARTBEAT_POLL    /* relayer sets a flag which is observed at limit checks */
+};
+
+enum HugePageMode {
+  HUGE_PAGES_NONE,
+  HUGE_PAGES_THP,     /* 2MiB-aligned regions with MADV_HUGEPAGE */
+  HUGE_PAGES_HUGETLB  /* explicitly reserved huge pages, falling back on THP */
+};
+
 struct GC_controls {
   bool mayLoadWorld;
   bool mayProcessAtMLton;
@@ -63,12 +103,22 @@ struct GC_controls {
   int heartbeatMicroseconds;
   uint32_t heartbeatTokens; /* number of tokens generated per heartbeat */
   int heartbeatRelayerThreshold;
+  uint32_t heartbeatRelayFanout; /* children per node of the relay tree */
+  enum HeartbeatMode heartbeatMode;
   size_t allocChunkSize;
   size_t blockSize;
   size_t allocBlocksMinSize;
+  size_t stackPoolSize; /* bytes of stack chunks kept per processor for reuse */
   size_t superblockThreshold; // upper bound on size-class of a superblock
   size_t megablockThreshold; // upper bound on size-class of a megablock (unmap above this threshold)
   struct timespec blockUsageSampleInterval;
+  struct timespec decommitDelay; /* how long blocks stay free before decommit */
+  size_t targetRSS; /* decommit eagerly above this many bytes (0 = no target) */
+  size_t megablockCacheSize; /* free megablocks each processor keeps for itself */
+  size_t maxHeap; /* die rather than map more heap than this (0 = no limit) */
+  size_t targetHeap; /* collect more eagerly above this many bytes in use (0 = no target) */
+  enum HugePageMode hugePages;
+  size_t hugePageSize; /* only meaningful if hugePages != HUGE_PAGES_NONE */
   float emptinessFraction;
   bool debugKeepFreeBlocks;
   bool manageEntanglement;
@@ -76,6 +126,13 @@ struct GC_controls {
   bool setAffinity; /* whether or not to set processor affinity */
   int32_t affinityBase; /* First processor to use when setting affinity */
   int32_t affinityStride; /* Number of processors between first and second */
+  bool affinityTopology; /* choose CPUs by cache and package (see processor.c) */
+  bool hashConsDuringGC; /* share equal immutable objects in local collections */
+  bool shrinkStacks; /* shrink suspended stacks in local collections */
+  uint32_t stackHibernateCollections; /* compact stacks suspended this long (0 = never) */
+  bool elasticWorkers; /* park workers beyond the CPU quota (see parallel.c) */
+  struct timespec elasticPeriod; /* how often to re-read the CPU quota */
+  bool numaAware; /* place blocks on the NUMA node of the allocating processor */
   struct GC_ratios ratios;
   struct HM_HierarchicalHeapConfig hhConfig;
   bool rusageMeasureGC;
@@ -93,5 +150,6 @@ struct GC_controls {
 
 static inline bool detailedGCTime (GC_state s);
 static inline bool needGCTime (GC_state s);
+static void initOverheadPolicy (struct GC_overheadPolicy *policy);
 
 #endif /* (defined (MLTON_GC_INTERNAL_FUNCS)) */
@@ -29,6 +29,8 @@ GC_thread copyThread (GC_state s, GC_thread from, size_t used) {
   copyStack (s,
              (GC_stack)(objptrToPointer(from->stack, NULL)),
              (GC_stack)(objptrToPointer(to->stack, NULL)));
+  copyStackSporkFrames ((GC_stack)(objptrToPointer(from->stack, NULL)),
+                        (GC_stack)(objptrToPointer(to->stack, NULL)));
   to->bytesNeeded = from->bytesNeeded;
   to->exnStack = from->exnStack;
 
@@ -59,6 +61,8 @@ GC_thread copyThreadWithHeap (GC_state s, GC_thread from, size_t used) {
   copyStack (s,
              (GC_stack)(objptrToPointer(from->stack, NULL)),
              (GC_stack)(objptrToPointer(to->stack, NULL)));
+  copyStackSporkFrames ((GC_stack)(objptrToPointer(from->stack, NULL)),
+                        (GC_stack)(objptrToPointer(to->stack, NULL)));
   to->bytesNeeded = from->bytesNeeded;
   to->exnStack = from->exnStack;
 
@@ -6,8 +6,15 @@
 
 // #define MAX(x, y) ((x) > (y) ? (x) : (y))
 
-#define MAX_FORK_DEPTH 31
-#define MAX_PATHS ((unsigned int) 1 << (MAX_FORK_DEPTH))
+/* A thread ID packs its fork path into 32 bits, which only fits tree depths
+ * below DECHECK_INLINE_DEPTH. Deeper IDs are "deep": their tree depth field
+ * holds DECHECK_DEEP_TAG, and their path field is the index of a node in the
+ * fork tree below (see struct decheck_node). Queries between two inline IDs
+ * are unchanged and O(1).
+ */
+#define DECHECK_INLINE_DEPTH 31
+#define DECHECK_DEEP_TAG 31
+#define MAX_PATHS ((unsigned int) 1 << (DECHECK_INLINE_DEPTH))
 #define MAX_DEPTH (1 << 27)
 
 #define SYNCH_DEPTHS_BASE ((void *) 0x100000000000)
@@ -20,14 +27,102 @@ static uint32_t *synch_depths = SYNCH_DEPTHS_BASE;
 #endif
 
 
-bool GC_HH_decheckMaxDepth(ARG_USED_FOR_DETECT_ENTANGLEMENT objptr resultRef) {
-#ifdef DETECT_ENTANGLEMENT
-  uint32_t *r = (uint32_t*)objptrToPointer(resultRef, NULL);
-  *r = MAX_FORK_DEPTH;
-  return TRUE;
-#else
+/* The fork depth of disentanglement checking is unbounded, so there is never
+ * a maximum depth to report. */
+bool GC_HH_decheckMaxDepth(__attribute__((unused)) objptr resultRef) {
   return FALSE;
-#endif
+}
+
+
+/* Positions in the fork tree that are too deep to be encoded inline are
+ * interned in a global binary trie: there is exactly one node per position,
+ * created the first time a fork reaches it, and the children of a node are
+ * installed with a CAS. Node 0 is the root (tree depth 0). Nodes are only
+ * created along paths that actually go deeper than DECHECK_INLINE_DEPTH-1,
+ * and are never freed.
+ *
+ * Because a position has a unique node, the sync depth of a deep position
+ * can be stored in the node itself instead of in the thread's
+ * decheckSyncDepths (which only covers the inline depths). This is the same
+ * value for every thread that can observe the position, just like the
+ * global synch_depths table that is checked in ASSERT builds.
+ */
+struct decheck_node {
+  uint32_t parent;
+  uint32_t treeDepth;
+  /* norm path of this position, or of its ancestor at depth
+   * DECHECK_INLINE_DEPTH-1 if this position is deeper */
+  uint32_t shallowPath;
+  volatile uint32_t syncDepth;
+  volatile uint32_t children[2]; /* 0 if not created yet */
+};
+
+#define DECHECK_NODE_BLOCK_BITS 16
+#define DECHECK_NODE_BLOCK_SIZE ((uint32_t)1 << DECHECK_NODE_BLOCK_BITS)
+#define DECHECK_NODE_NUM_BLOCKS ((uint32_t)1 << (32 - DECHECK_NODE_BLOCK_BITS))
+
+static struct decheck_node * volatile decheckNodeBlocks[DECHECK_NODE_NUM_BLOCKS];
+static volatile uint32_t decheckNumNodes = 0;
+
+static inline struct decheck_node* decheckNode(uint32_t idx) {
+  struct decheck_node *block = decheckNodeBlocks[idx >> DECHECK_NODE_BLOCK_BITS];
+  assert(NULL != block);
+  return &(block[idx & (DECHECK_NODE_BLOCK_SIZE-1)]);
+}
+
+static inline uint32_t decheckNewNode(void) {
+  uint32_t idx = __atomic_fetch_add(&decheckNumNodes, 1, __ATOMIC_RELAXED);
+  if (idx == UINT32_MAX) {
+    DIE("ran out of fork tree nodes for disentanglement checking");
+  }
+  uint32_t b = idx >> DECHECK_NODE_BLOCK_BITS;
+  if (NULL == __atomic_load_n(&decheckNodeBlocks[b], __ATOMIC_ACQUIRE)) {
+    struct decheck_node *block =
+      calloc_safe(DECHECK_NODE_BLOCK_SIZE, sizeof(struct decheck_node));
+    struct decheck_node *expected = NULL;
+    if (!__atomic_compare_exchange_n(&decheckNodeBlocks[b], &expected, block,
+                                     FALSE, __ATOMIC_RELEASE, __ATOMIC_ACQUIRE))
+      free(block);
+  }
+  return idx;
+}
+
+/* The node for child `bit` of node `idx`, creating it if necessary. */
+static inline uint32_t decheckNodeChild(uint32_t idx, uint32_t bit) {
+  struct decheck_node *n = decheckNode(idx);
+  uint32_t c = __atomic_load_n(&(n->children[bit]), __ATOMIC_ACQUIRE);
+  if (0 != c)
+    return c;
+
+  c = decheckNewNode();
+  struct decheck_node *cn = decheckNode(c);
+  uint32_t d = n->treeDepth;
+  cn->parent = idx;
+  cn->treeDepth = d+1;
+  cn->syncDepth = 0;
+  cn->children[0] = 0;
+  cn->children[1] = 0;
+  if (d+1 < DECHECK_INLINE_DEPTH)
+    cn->shallowPath = (n->shallowPath & ~(1u << d)) | (bit << d) | (1u << (d+1));
+  else
+    cn->shallowPath = n->shallowPath;
+
+  uint32_t expected = 0;
+  if (__atomic_compare_exchange_n(&(n->children[bit]), &expected, c,
+                                  FALSE, __ATOMIC_RELEASE, __ATOMIC_ACQUIRE))
+    return c;
+
+  /* Somebody else got there first. The node we made is just wasted. */
+  return expected;
+}
+
+/* The node of the inline position with the given norm path and depth. */
+static inline uint32_t decheckNodeOfPath(uint32_t path, unsigned int depth) {
+  uint32_t idx = 0;
+  for (unsigned int i = 0; i < depth; i++) {
+    idx = decheckNodeChild(idx, (path >> i) & 1);
+  }
+  return idx;
 }
 
 
@@ -43,6 +138,16 @@ void decheckInit(GC_state s) {
   synch_depths[1] = 0;
 #endif
 
+  uint32_t root = decheckNewNode();
+  assert(0 == root);
+  struct decheck_node *rn = decheckNode(root);
+  rn->parent = 0;
+  rn->treeDepth = 0;
+  rn->shallowPath = 1;
+  rn->syncDepth = 0;
+  rn->children[0] = 0;
+  rn->children[1] = 0;
+
   GC_thread thread = getThreadCurrent(s);
   thread->decheckState.internal.path = 1;
   thread->decheckState.internal.depth = 0;
@@ -59,7 +164,13 @@ inline void decheckInit(GC_state s) {
 }
 #endif
 
+static inline bool is_deep(decheck_tid_t tid) {
+  return (tid.internal.depth & 0x1f) == DECHECK_DEEP_TAG;
+}
+
 static inline unsigned int tree_depth(decheck_tid_t tid) {
+  if (is_deep(tid))
+    return decheckNode(tid.internal.path)->treeDepth;
   return tid.internal.depth & 0x1f;
 }
 
@@ -67,11 +178,27 @@ static inline unsigned int dag_depth(decheck_tid_t tid) {
   return tid.internal.depth >> 5;
 }
 
+/* Only meaningful for inline (not deep) IDs. */
 static inline uint32_t norm_path(decheck_tid_t tid) {
+  assert(!is_deep(tid));
   unsigned int td = tree_depth(tid);
   return tid.internal.path & ((1 << (td+1)) - 1);
 }
 
+/* The inline part of a path: the norm path and depth of the ID itself, or of
+ * its ancestor at depth DECHECK_INLINE_DEPTH-1 if it is deep. */
+static inline uint32_t shallow_path(decheck_tid_t tid) {
+  if (is_deep(tid))
+    return decheckNode(tid.internal.path)->shallowPath;
+  return norm_path(tid);
+}
+
+static inline unsigned int shallow_depth(decheck_tid_t tid) {
+  if (is_deep(tid))
+    return DECHECK_INLINE_DEPTH-1;
+  return tree_depth(tid);
+}
+
 
 #ifdef DETECT_ENTANGLEMENT
 static inline void decheckSetSyncDepth(GC_thread thread, uint32_t pathLen, uint32_t syncDepth) {
@@ -98,7 +225,28 @@ void GC_HH_decheckFork(GC_state s, uint64_t *left, uint64_t *right) {
   decheck_tid_t tid = thread->decheckState;
   assert(tid.bits != DECHECK_BOGUS_BITS);
   unsigned int h = tree_depth(tid);
-  assert(h < MAX_FORK_DEPTH);
+
+  if (h+1 >= DECHECK_INLINE_DEPTH) {
+    /* the children are deep */
+    uint32_t n =
+      is_deep(tid) ? tid.internal.path : decheckNodeOfPath(norm_path(tid), h);
+    uint32_t dd = dag_depth(tid) + 1;
+    assert(dd < MAX_DEPTH);
+
+    decheck_tid_t t1;
+    t1.internal.path = decheckNodeChild(n, 0);
+    t1.internal.depth = (dd << 5) | DECHECK_DEEP_TAG;
+    *left = t1.bits;
+
+    decheck_tid_t t2;
+    t2.internal.path = decheckNodeChild(n, 1);
+    t2.internal.depth = (dd << 5) | DECHECK_DEEP_TAG;
+    *right = t2.bits;
+
+    assert(tree_depth(t1) == h+1);
+    assert(tree_depth(t2) == h+1);
+    return;
+  }
 
   decheck_tid_t t1;
   t1.internal.path = (tid.internal.path & ~(1 << h)) | (1 << (h+1));
@@ -150,6 +298,11 @@ void GC_HH_decheckSetTid(GC_state s, uint64_t bits) {
   // setStateIfBogus(HM_getChunkOf((pointer)thread), tid);
   // setStateIfBogus(HM_getChunkOf((pointer)thread->stack), tid);
 
+  if (is_deep(tid)) {
+    decheckNode(tid.internal.path)->syncDepth = dag_depth(tid);
+    return;
+  }
+
   decheckSetSyncDepth(thread, tree_depth(tid), dag_depth(tid));
 
   assert(decheckGetSyncDepth(thread, tree_depth(tid)) == synch_depths[norm_path(tid)]);
@@ -189,6 +342,30 @@ void GC_HH_decheckJoin(GC_state s, uint64_t left, uint64_t right) {
   GC_thread thread = getThreadCurrent(s);
   unsigned int td = tree_depth(t1) - 1;
   unsigned int dd = MAX(dag_depth(t1), dag_depth(t2)) + 1;
+
+  if (is_deep(t1)) {
+    assert(is_deep(t2));
+    uint32_t p = decheckNode(t1.internal.path)->parent;
+    assert(p == decheckNode(t2.internal.path)->parent);
+    decheck_tid_t tid;
+    if (td >= DECHECK_INLINE_DEPTH) {
+      tid.internal.path = p;
+      tid.internal.depth = (dd << 5) | DECHECK_DEEP_TAG;
+      decheckNode(p)->syncDepth = dd;
+    }
+    else {
+      tid.internal.path = decheckNode(p)->shallowPath;
+      tid.internal.depth = (dd << 5) + td;
+#if ASSERT
+      synch_depths[norm_path(tid)] = dd;
+#endif
+      decheckSetSyncDepth(thread, td, dd);
+    }
+    thread->decheckState = tid;
+    assert(tree_depth(tid) == td);
+    return;
+  }
+
   assert(dag_depth(t1) == synch_depths[norm_path(t1)]);
   assert(dag_depth(t2) == synch_depths[norm_path(t2)]);
   decheck_tid_t tid;
@@ -265,11 +442,63 @@ static inline int bitIndex(uint32_t x) {
   return __builtin_ctz(x);
 }
 
+/** The tree depth of the LCA of two inline paths. */
+static inline unsigned int lcaShallowDepth(
+  uint32_t p1, unsigned int d1,
+  uint32_t p2, unsigned int d2)
+{
+  uint32_t p1mask = (1 << d1) - 1;
+  uint32_t p2mask = (1 << d2) - 1;
+  uint32_t shared_mask = p1mask & p2mask;
+  uint32_t shared_upper_bit = shared_mask+1;
+  uint32_t x = ((p1 ^ p2) & shared_mask) | shared_upper_bit;
+  return bitIndex(x & -x);
+}
+
+/** The tree depth of the LCA of two IDs, at least one of which is deep. If
+  * the LCA is itself deep, its node is returned in *lcaNode.
+  *
+  * This first compares the inline parts of the two paths in O(1). Only if
+  * both IDs are deep and share the same inline part does it walk up the
+  * fork tree, which takes time proportional to the distance to the LCA.
+  */
+static unsigned int lcaDeepDepth(
+  decheck_tid_t t1,
+  decheck_tid_t t2,
+  uint32_t *lcaNode)
+{
+  unsigned int d1 = shallow_depth(t1);
+  unsigned int d2 = shallow_depth(t2);
+  unsigned int l = lcaShallowDepth(shallow_path(t1), d1, shallow_path(t2), d2);
+  if (l < d1 || l < d2 || !is_deep(t1) || !is_deep(t2)) {
+    return l;
+  }
+
+  uint32_t n1 = t1.internal.path;
+  uint32_t n2 = t2.internal.path;
+  unsigned int h1 = decheckNode(n1)->treeDepth;
+  unsigned int h2 = decheckNode(n2)->treeDepth;
+  while (h1 > h2) { n1 = decheckNode(n1)->parent; h1--; }
+  while (h2 > h1) { n2 = decheckNode(n2)->parent; h2--; }
+  while (n1 != n2) {
+    n1 = decheckNode(n1)->parent;
+    n2 = decheckNode(n2)->parent;
+    h1--;
+  }
+  *lcaNode = n1;
+  return h1;
+}
+
 /** The heap depth of the LCA. Recall that heap depths are off-by-one; the
   * "root" of the hierarchy is at depth 1.
   */
 int lcaHeapDepth(decheck_tid_t t1, decheck_tid_t t2)
 {
+  if (is_deep(t1) || is_deep(t2)) {
+    uint32_t lcaNode;
+    return lcaDeepDepth(t1, t2, &lcaNode) + 1;
+  }
+
   /** This code is copied from isOrdered... */
   uint32_t p1 = norm_path(t1);
   uint32_t p1mask = (1 << tree_depth(t1)) - 1;
@@ -292,6 +521,18 @@ int lcaHeapDepth(decheck_tid_t t1, decheck_tid_t t2)
 #ifdef DETECT_ENTANGLEMENT
 bool decheckIsOrdered(GC_thread thread, decheck_tid_t t1)
 {
+  if (is_deep(t1) || is_deep(thread->decheckState)) {
+    uint32_t lcaNode = 0;
+    unsigned int llen = lcaDeepDepth(t1, thread->decheckState, &lcaNode);
+    if (llen == tree_depth(t1))
+      return TRUE;
+    uint32_t syncDepth =
+      (llen < DECHECK_INLINE_DEPTH)
+      ? decheckGetSyncDepth(thread, llen)
+      : decheckNode(lcaNode)->syncDepth;
+    return dag_depth(t1) <= syncDepth;
+  }
+
   uint32_t p1 = norm_path(t1);
   uint32_t p1mask = (1 << tree_depth(t1)) - 1;
   uint32_t p2 = norm_path(thread->decheckState);
@@ -609,9 +850,9 @@ bool decheck(GC_state s, objptr ptr)
 
 #ifdef DETECT_ENTANGLEMENT
 void GC_HH_copySyncDepthsFromThread(GC_state s, objptr fromThreadp, objptr toThreadp, uint32_t stealDepth) {
-  if (stealDepth > DECHECK_DEPTHS_LEN) {
-    DIE("attempted to copy sync depths up to %"PRIu32, stealDepth);
-  }
+  /* Only the inline depths are per-thread; the sync depths of deeper
+   * positions are shared in the fork tree nodes. */
+  (void)stealDepth;
 
   GC_thread fromThread = threadObjptrToStruct(s, fromThreadp);
   GC_thread toThread = threadObjptrToStruct(s, toThreadp);
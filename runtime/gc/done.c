@@ -47,6 +47,74 @@ static void displayGlobalCumulativeStatistics (
     //          uintmaxToCommaString (ChunkPool_maxAllocated ()));
 }
 
+/* Bytes of heap blocks that are currently resident, and how many of those
+ * are backed by huge pages. The latter is measured for the whole process,
+ * so it is capped at the former. */
+static void queryHugePageUsage(
+  GC_state s,
+  uintmax_t *residentBytes,
+  uintmax_t *hugePageBytes)
+{
+  size_t mapped;
+  size_t globalMapped;
+  size_t released;
+  size_t globalReleased;
+  size_t decommitted;
+  size_t allocated[NUM_BLOCK_PURPOSES];
+  size_t freed[NUM_BLOCK_PURPOSES];
+  size_t contended;
+  queryCurrentBlockUsage(
+    s,
+    &mapped,
+    &globalMapped,
+    &released,
+    &globalReleased,
+    &decommitted,
+    (size_t*)allocated,
+    (size_t*)freed,
+    &contended);
+
+  size_t blocks =
+    (released + decommitted >= mapped) ? 0 : mapped - released - decommitted;
+  *residentBytes = (uintmax_t)blocks * s->controls->blockSize;
+  *hugePageBytes = min(GC_hugePageResidentBytes(), *residentBytes);
+}
+
+/* Number of times a processor had to wait for the lock of a shared pool of
+ * free megablocks (see freeMegaBlock). */
+static uintmax_t queryMegaBlockLockContended(GC_state s) {
+  size_t mapped;
+  size_t globalMapped;
+  size_t released;
+  size_t globalReleased;
+  size_t decommitted;
+  size_t allocated[NUM_BLOCK_PURPOSES];
+  size_t freed[NUM_BLOCK_PURPOSES];
+  size_t contended;
+  queryCurrentBlockUsage(
+    s,
+    &mapped,
+    &globalMapped,
+    &released,
+    &globalReleased,
+    &decommitted,
+    (size_t*)allocated,
+    (size_t*)freed,
+    &contended);
+  return (uintmax_t)contended;
+}
+
+static void displayHugePageStatistics(FILE *out, GC_state s) {
+  uintmax_t residentBytes;
+  uintmax_t hugePageBytes;
+  queryHugePageUsage(s, &residentBytes, &hugePageBytes);
+  fprintf (out, "huge pages: %s of %s heap bytes (%.1f%%)\n",
+           uintmaxToCommaString (hugePageBytes),
+           uintmaxToCommaString (residentBytes),
+           (0 == residentBytes) ?
+           0.0 : 100.0 * ((double) hugePageBytes) / (double)residentBytes);
+}
+
 static void displayHHAllocStats(FILE *out, GC_state s) {
   FixedSizeAllocator fsa = getHHAllocator(s);
   fprintf(out, "num hh allocated: %zu\n", numFixedSizeAllocated(fsa));
@@ -150,6 +218,77 @@ static void displayCumulativeStatistics (FILE *out, struct GC_cumulativeStatisti
            uintmaxToCommaString (cumulativeStatistics->bytesScannedMinor));
   fprintf (out, "bytes hash consed: %s bytes\n",
            uintmaxToCommaString (cumulativeStatistics->bytesHashConsed));
+  fprintf (out, "weak pointers cleared: %s\n",
+           uintmaxToCommaString (cumulativeStatistics->numWeaksCleared));
+  fprintf (out, "stacks shrunk: %s (%s hibernated), %s bytes reclaimed\n",
+           uintmaxToCommaString (cumulativeStatistics->numStacksShrunk),
+           uintmaxToCommaString (cumulativeStatistics->numStacksHibernated),
+           uintmaxToCommaString (cumulativeStatistics->bytesReclaimedFromStacks));
+  fprintf (out, "blocks freed for other processors: %s (in %s batches)\n",
+           uintmaxToCommaString (cumulativeStatistics->numBlocksFreedForOthers),
+           uintmaxToCommaString (cumulativeStatistics->numRemoteFreeBatches));
+  fprintf (out, "blocks reclaimed from other processors: %s\n",
+           uintmaxToCommaString (cumulativeStatistics->numBlocksReclaimedFromOthers));
+  if (cumulativeStatistics->numParallelLocalGCs > 0) {
+    double scanTime =
+      (double)cumulativeStatistics->timeLocalGCParallelScan.tv_sec
+      + (double)cumulativeStatistics->timeLocalGCParallelScan.tv_nsec / 1e9;
+    double workTime =
+      (double)cumulativeStatistics->timeLocalGCParallelWork.tv_sec
+      + (double)cumulativeStatistics->timeLocalGCParallelWork.tv_nsec / 1e9;
+    fprintf (out, "parallel local GCs: %s (%s helpers joined, %.2fx speedup)\n",
+             uintmaxToCommaString (cumulativeStatistics->numParallelLocalGCs),
+             uintmaxToCommaString (cumulativeStatistics->numLocalGCHelpers),
+             (0.0 == scanTime) ? 1.0 : workTime / scanTime);
+  }
+  if (cumulativeStatistics->numLocalGCsHelped > 0) {
+    fprintf (out, "helped other local GCs: %s times, %s bytes copied\n",
+             uintmaxToCommaString (cumulativeStatistics->numLocalGCsHelped),
+             uintmaxToCommaString (cumulativeStatistics->bytesCopiedHelpingLocalGC));
+  }
+  if (cumulativeStatistics->numParallelCCs > 0) {
+    double markTime =
+      (double)cumulativeStatistics->timeCCParallelMark.tv_sec
+      + (double)cumulativeStatistics->timeCCParallelMark.tv_nsec / 1e9;
+    double workTime =
+      (double)cumulativeStatistics->timeCCParallelWork.tv_sec
+      + (double)cumulativeStatistics->timeCCParallelWork.tv_nsec / 1e9;
+    fprintf (out, "parallel CCs: %s (%s helpers joined, %.2fx speedup)\n",
+             uintmaxToCommaString (cumulativeStatistics->numParallelCCs),
+             uintmaxToCommaString (cumulativeStatistics->numCCHelpers),
+             (0.0 == markTime) ? 1.0 : workTime / markTime);
+  }
+  if (cumulativeStatistics->numCCsHelped > 0) {
+    fprintf (out, "helped other CCs: %s times, %s bytes marked\n",
+             uintmaxToCommaString (cumulativeStatistics->numCCsHelped),
+             uintmaxToCommaString (cumulativeStatistics->bytesMarkedHelpingCC));
+  }
+  if (cumulativeStatistics->numStacksPooled > 0) {
+    uintmax_t hits = cumulativeStatistics->numStackPoolHits;
+    uintmax_t total = hits + cumulativeStatistics->numStackPoolMisses;
+    fprintf (out, "stack pool: %s stacks pooled, %s of %s new threads reused one (%.1f%%)\n",
+             uintmaxToCommaString (cumulativeStatistics->numStacksPooled),
+             uintmaxToCommaString (hits),
+             uintmaxToCommaString (total),
+             (0 == total) ? 0.0 : 100.0 * (double)hits / (double)total);
+  }
+  if (cumulativeStatistics->numIdleParks > 0) {
+    fprintf (out, "idle parks: %s (%s wakeups sent, %s ms parked)\n",
+             uintmaxToCommaString (cumulativeStatistics->numIdleParks),
+             uintmaxToCommaString (cumulativeStatistics->numIdleWakeups),
+             uintmaxToCommaString (
+               (uintmax_t)cumulativeStatistics->timeIdleParked.tv_sec * 1000
+               + (uintmax_t)cumulativeStatistics->timeIdleParked.tv_nsec / 1000000));
+  }
+  if (cumulativeStatistics->numElasticParks > 0
+      || cumulativeStatistics->numActiveWorkerChanges > 0) {
+    fprintf (out, "elastic parks: %s (%s changes of active workers, %s ms parked)\n",
+             uintmaxToCommaString (cumulativeStatistics->numElasticParks),
+             uintmaxToCommaString (cumulativeStatistics->numActiveWorkerChanges),
+             uintmaxToCommaString (
+               (uintmax_t)cumulativeStatistics->timeElasticParked.tv_sec * 1000
+               + (uintmax_t)cumulativeStatistics->timeElasticParked.tv_nsec / 1000000));
+  }
   fprintf (out, "sync for old gen array: %s\n",
            uintmaxToCommaString (cumulativeStatistics->syncForOldGenArray));
   fprintf (out, "sync for new gen array: %s\n",
@@ -205,6 +344,24 @@ static void displayCumulativeStatisticsJSON (FILE *out, GC_state s) {
 
     fprintf(out, ", ");
 
+    fprintf(out,
+            "\"megaBlockLockContended\" : %"PRIuMAX,
+            queryMegaBlockLockContended(s));
+
+    if (HUGE_PAGES_NONE != s->controls->hugePages) {
+      uintmax_t residentBytes;
+      uintmax_t hugePageBytes;
+      queryHugePageUsage(s, &residentBytes, &hugePageBytes);
+
+      fprintf(out, ", ");
+
+      fprintf(out, "\"heapResidentBytes\" : %"PRIuMAX, residentBytes);
+
+      fprintf(out, ", ");
+
+      fprintf(out, "\"hugePageBytes\" : %"PRIuMAX, hugePageBytes);
+    }
+
     // SAM_NOTE: TODO: removed for now; will need to replace with blocks statistics
     // fprintf(out,
     //         "\"maxChunkPoolOccupancy\" : %"PRIuMAX,
@@ -261,6 +418,10 @@ void GC_done(GC_state s) {
       displayGlobalCumulativeStatistics
               (s->controls->summaryFile,
                s->globalCumulativeStatistics);
+      fprintf (s->controls->summaryFile, "megablock lock contended: %s\n",
+               uintmaxToCommaString (queryMegaBlockLockContended(s)));
+      if (HUGE_PAGES_NONE != s->controls->hugePages)
+        displayHugePageStatistics(s->controls->summaryFile, s);
       if (s->procStates) {
         for (uint32_t proc = 0; proc < s->numberOfProcs; proc++) {
           fprintf (s->controls->summaryFile, "Thread [%d]::\n", proc);
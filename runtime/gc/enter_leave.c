@@ -41,6 +41,7 @@ void leave (GC_state s) {
    */
   assert(invariantForMutator(s, FALSE, TRUE));
   s->spareHeartbeatTokens = getThreadCurrent(s)->spareHeartbeatTokens;
+  HM_HH_updateWriteBarrierLevelHead(s);
   endAtomic (s);
   // Trace0(EVENT_RUNTIME_LEAVE);
 }
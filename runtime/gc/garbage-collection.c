@@ -75,12 +75,15 @@ void growStackCurrent(GC_state s) {
   stack = (GC_stack)(frontier + GC_HEADER_SIZE);
   stack->reserved = reserved;
   stack->used = 0;
+  stack->lastUsed = 0;
+  stack->suspendedCollections = 0;
   HM_updateChunkFrontierInList(
     HM_HH_getChunkList(newhh),
     newChunk,
     frontier + stackSize);
 
   copyStack(s, getStackCurrent(s), stack);
+  moveStackSporkFrames(getStackCurrent(s), stack);
   getThreadCurrent(s)->stack = pointerToObjptr((pointer)stack, NULL);
 
   assert(getThreadCurrent(s)->currentChunk != chunk);
@@ -91,6 +94,8 @@ void growStackCurrent(GC_state s) {
 void GC_collect (GC_state s, size_t bytesRequested, bool force) {
   enter(s);
   maybeSample(s, s->blockUsageSampler);
+  publishRemoteFrees(s);
+  maybeDecommitIdleBlocks(s);
 
   // HM_HierarchicalHeap h = getThreadCurrent(s)->hierarchicalHeap;
   // while (h->nextAncestor != NULL) h = h->nextAncestor;
@@ -114,6 +119,7 @@ void GC_collect (GC_state s, size_t bytesRequested, bool force) {
   assert(bytesRequested + sizeof(struct HM_chunk) <= s->controls->blockSize);
 
   getThreadCurrent(s)->bytesNeeded = bytesRequested;
+  receivePolledHeartbeat(s);
   switchToSignalHandlerThreadIfNonAtomicAndSignalPending(s);
 
   /* SAM_NOTE: don't use HM_HH_getFrontier here, because invariant is possibly
@@ -49,6 +49,7 @@ void setGCStateCurrentThreadAndStack (GC_state s) {
   s->stackBottom = getStackBottom (s, stack);
   s->stackTop = getStackTop (s, stack);
   s->stackLimit = getStackLimit (s, stack);
+  HM_HH_updateWriteBarrierLevelHead(s);
 }
 
 struct FixedSizeAllocator* getHHAllocator(GC_state s) {
@@ -94,6 +95,10 @@ uint32_t GC_getHeartbeatRelayerThreshold(GC_state s) {
   return (uint32_t)s->controls->heartbeatRelayerThreshold;
 }
 
+Bool_t GC_getHeartbeatPolling(GC_state s) {
+  return (Bool_t)(HEARTBEAT_POLL == s->controls->heartbeatMode);
+}
+
 // SAM_NOTE: TODO: remove this and replace with blocks statistics
 size_t GC_getMaxChunkPoolOccupancy (void) {
   return 0;
@@ -147,6 +152,16 @@ uintmax_t GC_getCumulativeStatisticsBytesPromoted (GC_state s) {
   return retVal;
 }
 
+uintmax_t GC_getCumulativeStatisticsBytesHashConsed (GC_state s) {
+  /* sum over all procs */
+  uintmax_t retVal = 0;
+  for (uint32_t p = 0; p < s->numberOfProcs; p++) {
+    retVal += s->procStates[p].cumulativeStatistics->bytesHashConsed;
+  }
+
+  return retVal;
+}
+
 uintmax_t GC_getCumulativeStatisticsNumCopyingGCs (GC_state s) {
   /* return sum across all processors */
   uintmax_t retVal = 0;
@@ -335,9 +350,8 @@ uintmax_t GC_maxStackSizeForHeartbeat(GC_state s) {
   return count;
 }
 
-__attribute__((noreturn))
-void GC_setHashConsDuringGC(__attribute__((unused)) GC_state s, __attribute__((unused)) Bool_t b) {
-  DIE("GC_setHashConsDuringGC unsupported");
+void GC_setHashConsDuringGC(GC_state s, Bool_t b) {
+  s->controls->hashConsDuringGC = b;
 }
 
 size_t GC_getLastMajorStatisticsBytesLive (GC_state s) {
@@ -33,7 +33,9 @@ struct GC_state {
   volatile uint32_t atomicState;
   struct BlockAllocator *blockAllocatorGlobal;
   struct BlockAllocator *blockAllocatorLocal;
+  uintptr_t blockMask; /* ~(HM_BLOCK_SIZE - 1), read by the mutator */
   struct Sampler *blockUsageSampler;
+  struct Sampler *heapUsageSampler; /* see getRecentHeapBytesInUse */
   objptr callFromCHandlerThread; /* Handler for exported C calls (in heap). */
   pointer callFromCOpArgsResPtr; /* Pass op, args, and res from exported C call */
   struct GC_controls *controls;
@@ -47,6 +49,7 @@ struct GC_state {
   uint32_t frameInfosLength; /* Cardinality of frameInfos array. */
   struct HM_chunkList freeListSmall;
   struct HM_chunkList freeListLarge;
+  struct HM_chunkList stackChunkPool; /* stacks of joined threads, for reuse */
   size_t nextChunkAllocSize;
   /* Ordinary globals */
   objptr *globals;
@@ -57,6 +60,8 @@ struct GC_state {
   struct EBR_shared * hmEBR;
   struct timespec lastHeartbeatBroadcast;
   struct GC_lastMajorStatistics *lastMajorStatistics;
+  struct LGC_parallelJob *lgcJob; /* for inviting helpers into local GCs */
+  struct CC_parallelJob *ccJob; /* for inviting helpers into CCs */
   pointer limitPlusSlop; /* limit + GC_HEAP_LIMIT_SLOP */
   int (*loadGlobals)(FILE *f); /* loads the globals from the file. */
   uint32_t magic; /* The magic number for this executable. */
@@ -65,9 +70,12 @@ struct GC_state {
   bool mutatorMarksCards;
   /* The maximum amount of concurrency */
   uint32_t numberOfProcs;
+  uint32_t *procCPUs; /* CPU of each processor, or NULL if not pinned */
+  uint8_t *procDistances; /* numberOfProcs^2, see GC_processorDistance */
   size_t numberDisentanglementChecks;  /** TODO: remove. now in cumulativeStatistics */
   GC_objectType objectTypes; /* Array of object types. */
   uint32_t objectTypesLength; /* Cardinality of objectTypes array. */
+  struct GC_overheadPolicy overheadPolicy;
   int32_t procNumber;
   /* States for each processor */
   GC_state procStates;
@@ -98,8 +106,16 @@ struct GC_state {
                                 * 1: okay to terminate
                                 * 0: ready to terminate
                                 */
+  uint32_t heartbeatRelayPending; /* set before the relayer (or our parent in
+                                   * the relay tree) sends us SIGUSR1; tells
+                                   * GC_handler to relay to our children. */
+  uint32_t heartbeatPollPending; /* heartbeat-mode poll: set by the relayer,
+                                  * consumed at the next runtime entry. */
   GC_weak weaks; /* Linked list of (live) weak pointers */
   char *worldFile;
+  /* The union-find node of the current thread's heap, or NULL. The mutator
+   * compares chunk level heads against this to skip GC_writeBarrier. */
+  struct HM_UnionFindNode *writeBarrierLevelHead;
   struct TracingContext *trace;
   struct TLSObjects tlsObjects;
 };
@@ -130,6 +146,7 @@ PRIVATE size_t GC_getMaxChunkPoolOccupancy (void);
 PRIVATE size_t GC_getGlobalCumulativeStatisticsMaxHeapOccupancy (GC_state s);
 PRIVATE uintmax_t GC_getCumulativeStatisticsBytesAllocated (GC_state s);
 PRIVATE uintmax_t GC_getCumulativeStatisticsBytesPromoted (GC_state s);
+PRIVATE uintmax_t GC_getCumulativeStatisticsBytesHashConsed (GC_state s);
 PRIVATE uintmax_t GC_getCumulativeStatisticsNumCopyingGCs (GC_state s);
 PRIVATE uintmax_t GC_getCumulativeStatisticsNumMarkCompactGCs (GC_state s);
 PRIVATE uintmax_t GC_getCumulativeStatisticsNumMinorGCs (GC_state s);
@@ -167,6 +184,7 @@ PRIVATE uintmax_t GC_maxStackSizeForHeartbeat(GC_state s);
 PRIVATE uint32_t GC_getHeartbeatMicroseconds(GC_state s);
 PRIVATE uint32_t GC_getHeartbeatTokens(GC_state s);
 PRIVATE uint32_t GC_getHeartbeatRelayerThreshold(GC_state s);
+PRIVATE Bool_t GC_getHeartbeatPolling(GC_state s);
 
 PRIVATE pointer GC_getCallFromCHandlerThread (GC_state s);
 PRIVATE void GC_setCallFromCHandlerThreads (GC_state s, pointer p);
@@ -81,15 +81,23 @@ void switchToSignalHandlerThreadIfNonAtomicAndSignalPending (GC_state s) {
   }
 }
 
-static inline void relaySignalTo(GC_state s, int id, int signum) {
-  if (id == Proc_processorNumber(s))
-    return;
+/* Like GC_CheckForTerminationRequest, but without tracing, because this might
+ * be called by the relayer thread with the GC_state of processor 0. */
+static inline bool terminationRequested(GC_state s) {
+  return atomicLoadU32(&(s->procStates[0].terminationLeader))
+         != INVALID_PROCESSOR_NUMBER;
+}
 
+/* Send signum to processor id, unless it has terminated (or is about to).
+ * Does not depend on the identity of the caller, so this is also used by the
+ * relayer thread, which is not a processor.
+ */
+static inline void signalProcessor(GC_state s, int id, int signum) {
   // first, try to prevent them from terminating
   uint32_t *statusp = &(s->procStates[id].terminationStatus);
   uint32_t status = atomicLoadU32(statusp);
   bool success = FALSE;
-  while (status > 0 && !GC_CheckForTerminationRequest(s)) {
+  while (status > 0 && !terminationRequested(s)) {
     success = __sync_bool_compare_and_swap(statusp, status, status+1);
     if (success)
       break;
@@ -104,6 +112,12 @@ static inline void relaySignalTo(GC_state s, int id, int signum) {
   }
 }
 
+static inline void relaySignalTo(GC_state s, int id, int signum) {
+  if (id == Proc_processorNumber(s))
+    return;
+  signalProcessor(s, id, signum);
+}
+
 
 void GC_sendHeartbeatToOtherProc(GC_state s, uint32_t target) {
   enter(s);
@@ -137,47 +151,143 @@ void broadcastHeartbeat(GC_state s) {
 }
 
 
-/* broadcast a heartbeat if ready, and then return number of microseconds
- * remaining until next heartbeat is due
+/* For large numbers of processors, heartbeats are delivered by the relayer
+ * thread (see startHeartbeatRelayer) through a relay tree with
+ * heartbeatRelayFanout children per node. The roots of the tree are
+ * processors 0 through F-1, and the children of processor p are processors
+ * (p+1)*F through (p+1)*F + F-1. Each node only relays if the
+ * heartbeatRelayPending flag was set by its parent, so that heartbeats sent
+ * directly to one processor (GC_sendHeartbeatToOtherProc) are not relayed.
  */
-void checkBroadcastHeartbeat(GC_state s, struct timespec *rem) {
-  struct timespec now;
-  timespec_now(&now);
+static inline void relayHeartbeatToRange(GC_state s, uint32_t lo, uint32_t hi) {
+  for (uint32_t p = lo;
+       p < hi && p < s->numberOfProcs && !terminationRequested(s);
+       p++)
+  {
+    __atomic_store_n(&(s->procStates[p].heartbeatRelayPending), 1, __ATOMIC_RELEASE);
+    signalProcessor(s, p, SIGUSR1);
+  }
+}
 
-  struct timespec elapsedSinceLast = now;
-  timespec_sub(&elapsedSinceLast, &(s->lastHeartbeatBroadcast));
+static inline void relayHeartbeatToChildren(GC_state s) {
+  uint32_t fanout = s->controls->heartbeatRelayFanout;
+  uint32_t me = (uint32_t)Proc_processorNumber(s);
+  uint64_t start = ((uint64_t)me + 1) * fanout;
+  if (start >= s->numberOfProcs)
+    return;
+  relayHeartbeatToRange(s, (uint32_t)start, (uint32_t)start + fanout);
+}
 
-  struct timespec desired;
-  desired.tv_sec = s->controls->heartbeatMicroseconds / 1000000;
-  desired.tv_nsec = 1000 * (s->controls->heartbeatMicroseconds % 1000000);
-  *rem = desired;
 
-  if (timespec_geq(&elapsedSinceLast, &desired)) {
-    s->lastHeartbeatBroadcast = now;
-    broadcastHeartbeat(s);
+/* heartbeat-mode poll: instead of sending signals, the relayer marks each
+ * processor and forces its next limit check to fail. The processor then
+ * picks up the heartbeat in receivePolledHeartbeat, on its own thread.
+ */
+static inline void pollHeartbeatAll(GC_state s) {
+  for (uint32_t p = 0; p < s->numberOfProcs; p++) {
+    GC_state target = &(s->procStates[p]);
+    __atomic_store_n(&(target->heartbeatPollPending), 1, __ATOMIC_RELEASE);
+    /* Same as GC_handler: if the processor is in an atomic section, then
+     * endAtomic will notice the pending heartbeat instead. */
+    if (0 == __atomic_load_n(&(target->atomicState), __ATOMIC_ACQUIRE))
+      __atomic_store_n(&(target->limit), (pointer)NULL, __ATOMIC_RELAXED);
   }
-  else {
-    timespec_sub(rem, &elapsedSinceLast);
+}
+
+/* Turn a polled heartbeat into a pending SIGUSR1, exactly as if GC_handler
+ * had received one. Must be called by the processor that owns s. */
+void receivePolledHeartbeat(GC_state s) {
+  if (HEARTBEAT_POLL != s->controls->heartbeatMode)
+    return;
+  if (!__atomic_exchange_n(&(s->heartbeatPollPending), 0, __ATOMIC_ACQ_REL))
+    return;
+
+  if (s->controls->heartbeatStats) {
+    struct timespec now;
+    timespec_now(&now);
+    struct timespec diff = now;
+    timespec_sub(&diff, &(s->cumulativeStatistics->lastHeartbeatSignalTimestamp));
+    TimeHistogram_insert(s->cumulativeStatistics->heartbeatSignals, &diff);
+    s->cumulativeStatistics->lastHeartbeatSignalTimestamp = now;
   }
 
-  return;
+  s->signalsInfo.signalIsPending = TRUE;
+  sigaddset (&s->signalsInfo.signalsPending, SIGUSR1);
+}
+
+bool heartbeatRelayerNeeded(GC_state s) {
+  if (HEARTBEAT_POLL == s->controls->heartbeatMode)
+    return TRUE;
+  return s->numberOfProcs >= 2
+         && s->numberOfProcs > (uint32_t)s->controls->heartbeatRelayerThreshold;
 }
 
 
 void relayerLoop(GC_state s) {
-  // struct timespec hiccup;
-  // hiccup.tv_sec = 0;
-  // hiccup.tv_nsec = 200000;
-
-  while (TRUE) {
-    GC_MayTerminateThread(s);
-    struct timespec rem;
-    checkBroadcastHeartbeat(s, &rem);
-    // if (timespec_geq(&rem, &hiccup)) {
-    //   timespec_sub(&rem, &hiccup);
-    //   nanosleep(&rem, NULL);
-    // }
+  struct timespec period;
+  period.tv_sec = s->controls->heartbeatMicroseconds / 1000000;
+  period.tv_nsec = 1000 * (s->controls->heartbeatMicroseconds % 1000000);
+
+  /* Wait (without spinning) for the processors to come up. */
+  while (!Proc_isInitialized(s)) {
+    if (terminationRequested(s))
+      return;
+    nanosleep(&period, NULL);
+  }
+
+  struct timespec next;
+  timespec_now(&next);
+
+  while (!terminationRequested(s)) {
+    timespec_add(&next, &period);
+
+    struct timespec now;
+    timespec_now(&now);
+    if (timespec_geq(&now, &next)) {
+      /* We fell behind (e.g. we were descheduled). Don't try to catch up
+       * with a burst of heartbeats; just start again from now. */
+      next = now;
+    }
+    else {
+      struct timespec rem = next;
+      timespec_sub(&rem, &now);
+      while (0 != nanosleep(&rem, &rem) && EINTR == errno) {}
+    }
+
+    if (HEARTBEAT_POLL == s->controls->heartbeatMode)
+      pollHeartbeatAll(s);
+    else
+      relayHeartbeatToRange(s, 0, s->controls->heartbeatRelayFanout);
+  }
+}
+
+
+static void* relayerThreadFunc(void *arg) {
+  GC_state s = (GC_state)arg;
+
+  /* The relayer is not a processor, so it must not receive any of the
+   * process-directed signals that the processors handle. */
+  sigset_t all;
+  sigfillset(&all);
+  pthread_sigmask(SIG_BLOCK, &all, NULL);
+
+  relayerLoop(s);
+  return NULL;
+}
+
+
+/* Start a dedicated thread which sleeps until each heartbeat is due and then
+ * starts the relay tree (or, in heartbeat-mode poll, marks every processor).
+ * The thread is not one of the processors: it never runs ML code and spends
+ * nearly all of its time asleep.
+ */
+void startHeartbeatRelayer(GC_state s) {
+  pthread_t relayer;
+  int err = pthread_create(&relayer, NULL, &relayerThreadFunc, (void*)s);
+  if (err) {
+    DIE("pthread_create failed for heartbeat relayer: %s", strerror(err));
   }
+  pthread_detach(relayer);
 }
 
 /* GC_handler sets s->limit = 0 so that the next limit check will
@@ -233,6 +343,12 @@ void GC_handler (int signum) {
     s->cumulativeStatistics->lastHeartbeatSignalTimestamp = now;
   }
 
+  if (signum == SIGUSR1
+      && __atomic_exchange_n(&(s->heartbeatRelayPending), 0, __ATOMIC_ACQ_REL))
+  {
+    relayHeartbeatToChildren(s);
+  }
+
   if (signum == SIGALRM) {
     // if (me != 0) {
     //   relaySignalTo(s, 0, SIGALRM);
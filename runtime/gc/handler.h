@@ -12,6 +12,9 @@
 static inline void switchToSignalHandlerThreadIfNonAtomicAndSignalPending (GC_state s);
 
 void relayerLoop(GC_state s);
+void startHeartbeatRelayer(GC_state s);
+bool heartbeatRelayerNeeded(GC_state s);
+void receivePolledHeartbeat(GC_state s);
 
 #endif /* (defined (MLTON_GC_INTERNAL_FUNCS)) */
 
@@ -61,6 +61,26 @@ void unmarkWrapper(
 void addEntangledToRemSet(GC_state s, objptr op, uint32_t opDepth, struct ForwardHHObjptrArgs *args);
 
 static inline HM_HierarchicalHeap toSpaceHH (GC_state s, struct ForwardHHObjptrArgs *args, uint32_t depth) {
+  if (NULL != args->job)
+  {
+    /* Parallel collection: other participants might be racing to create
+     * the same level. The new heap is always allocated by the owner of the
+     * collection. */
+    HM_HierarchicalHeap hh = __atomic_load_n(&(args->toSpace[depth]), __ATOMIC_ACQUIRE);
+    if (NULL != hh)
+      return hh;
+
+    spinlock_lock(&(args->job->lock), Proc_processorNumber(s));
+    hh = args->toSpace[depth];
+    if (NULL == hh)
+    {
+      hh = HM_HH_new(args->job->owner, depth);
+      __atomic_store_n(&(args->toSpace[depth]), hh, __ATOMIC_RELEASE);
+    }
+    spinlock_unlock(&(args->job->lock));
+    return hh;
+  }
+
   if (args->toSpace[depth] == NULL)
   {
     /* Level does not exist, so create it */
@@ -99,7 +119,39 @@ pointer copyObject(pointer p,
                    size_t copySize,
                    HM_HierarchicalHeap tgtHeap);
 
-void delLastObj(objptr op, size_t objectSize, HM_HierarchicalHeap tgtHeap);
+/* Same as copyObject, but copies into the given chunklist, whose chunks
+ * are then assigned to tgtHeap. */
+pointer copyObjectIntoList(pointer p,
+                           size_t objectSize,
+                           size_t copySize,
+                           HM_HierarchicalHeap tgtHeap,
+                           HM_chunkList tgtChunkList);
+
+void delLastObj(objptr op, size_t objectSize, HM_chunkList tgtChunkList);
+
+static void LGC_processWeaks(GC_state s, struct ForwardHHObjptrArgs *args);
+static void LGC_recordWeak(GC_state s, struct ForwardHHObjptrArgs *args, objptr op);
+static objptr LGC_shrinkStack(GC_state s,
+                              struct ForwardHHObjptrArgs *args,
+                              pointer p,
+                              HM_HierarchicalHeap tgtHeap,
+                              HM_chunkList tgtChunkList);
+static struct LGC_hashConsTable *LGC_newHashConsTable(void);
+static void LGC_freeHashConsTable(struct LGC_hashConsTable *t);
+
+/**
+ * Scan the objects at `depth` in the to-space, starting at `start` in
+ * `startChunk`, with the help of any idle processors that join in. See
+ * struct LGC_parallelJob.
+ */
+void LGC_parallelScanDepth(
+    GC_state s,
+    struct ForwardHHObjptrArgs *args,
+    uint32_t depth,
+    HM_chunk startChunk,
+    pointer start);
+
+void LGC_participate(GC_state s, struct LGC_parallelJob *job, uint32_t slot);
 
 /**
  * ObjptrPredicateFunction for skipping stacks and threads in the hierarchical
@@ -121,6 +173,63 @@ bool skipStackAndThreadObjptrPredicate(GC_state s,
 /* Function Definitions */
 /************************/
 #if (defined(MLTON_GC_INTERNAL_BASIS))
+
+Bool GC_HH_tryHelpLocalCollection(GC_state s)
+{
+  if (!s->controls->hhConfig.parallelLocalCollection)
+    return FALSE;
+
+  bool helped = FALSE;
+  uint32_t me = Proc_processorNumber(s);
+  for (uint32_t i = 1; i < s->numberOfProcs && !helped; i++)
+  {
+    struct LGC_parallelJob *job =
+      s->procStates[(me + i) % s->numberOfProcs].lgcJob;
+    uint32_t state = __atomic_load_n(&(job->state), __ATOMIC_ACQUIRE);
+    if (!(state & LGC_JOB_OPEN))
+      continue;
+
+    /* attach; this fails if the job was closed in the meantime */
+    if (!__sync_bool_compare_and_swap(&(job->state), state, state + 1))
+      continue;
+
+    uint32_t slot = __sync_fetch_and_add(&(job->nextSlot), 1);
+    if (slot < job->maxParticipants)
+    {
+      enter(s);
+      LOG(LM_HH_COLLECTION, LL_DEBUG,
+          "helping local collection of processor %u at depth %u",
+          Proc_processorNumber(job->owner),
+          job->depth);
+      LGC_participate(s, job, slot);
+      s->cumulativeStatistics->numLocalGCsHelped++;
+      s->cumulativeStatistics->bytesCopiedHelpingLocalGC +=
+        job->stats[slot].bytesCopied;
+      leave(s);
+      helped = TRUE;
+    }
+
+    /* detach; the owner waits for this before reusing the job */
+    __sync_fetch_and_sub(&(job->state), 1);
+  }
+
+  return helped;
+}
+
+Bool GC_HH_anyLocalCollectionJobOpen(GC_state s)
+{
+  if (!s->controls->hhConfig.parallelLocalCollection)
+    return FALSE;
+
+  for (uint32_t i = 0; i < s->numberOfProcs; i++)
+  {
+    struct LGC_parallelJob *job = s->procStates[i].lgcJob;
+    if (__atomic_load_n(&(job->state), __ATOMIC_SEQ_CST) & LGC_JOB_OPEN)
+      return TRUE;
+  }
+  return FALSE;
+}
+
 #endif /* MLTON_GC_INTERNAL_BASIS */
 
 #if (defined(MLTON_GC_INTERNAL_FUNCS))
@@ -314,10 +423,20 @@ void HM_HHC_collectLocal(uint32_t desiredScope)
       .stacksCopied = 0,
       .bytesMoved = 0,
       .objectsMoved = 0,
-      .concurrent = false};
+      .concurrent = false,
+      .job = NULL,
+      .toSpaceLocal = NULL,
+      .hashCons = NULL,
+      .currentStack = (pointer)getStackCurrent(s),
+      .weaks = NULL};
   CC_workList_init(s, &(forwardHHObjptrArgs.worklist));
   struct GC_foreachObjptrClosure forwardHHObjptrClosure =
       {.fun = forwardHHObjptr, .env = &forwardHHObjptrArgs};
+  if (s->controls->hashConsDuringGC)
+    forwardHHObjptrArgs.hashCons = LGC_newHashConsTable();
+  struct HM_chunkList weaks;
+  HM_initChunkList(&weaks);
+  forwardHHObjptrArgs.weaks = &weaks;
 
   LOG(LM_HH_COLLECTION, LL_INFO,
       "collecting hh %p (L: %u):\n"
@@ -391,6 +510,27 @@ void HM_HHC_collectLocal(uint32_t desiredScope)
     totalSizeBefore += sz;
   }
 
+  /* Only worth inviting helpers if there is a decent amount of work. */
+  struct LGC_parallelJob *job = s->lgcJob;
+  bool parallel =
+    s->controls->hhConfig.parallelLocalCollection &&
+    s->numberOfProcs > 1 &&
+    s->controls->hhConfig.maxLocalCollectionHelpers > 0 &&
+    totalSizeBefore >= s->controls->hhConfig.minParallelLocalCollectionSize;
+  if (parallel)
+  {
+    job->maxParticipants =
+      min(s->numberOfProcs, s->controls->hhConfig.maxLocalCollectionHelpers + 1);
+    size_t numLists = (size_t)job->maxParticipants * (maxDepth + 1);
+    job->toSpaceLocal =
+      (struct HM_chunkList *)malloc_safe(numLists * sizeof(struct HM_chunkList));
+    for (size_t i = 0; i < numLists; i++)
+      HM_initChunkList(&(job->toSpaceLocal[i]));
+    job->stats = (struct LGC_participantStats *)
+      malloc_safe(job->maxParticipants * sizeof(struct LGC_participantStats));
+    s->cumulativeStatistics->numParallelLocalGCs++;
+  }
+
   /* ===================================================================== */
   /* ===================================================================== */
 
@@ -627,6 +767,11 @@ void HM_HHC_collectLocal(uint32_t desiredScope)
       HM_chunkList toSpaceList = HM_HH_getChunkList(toSpaceLevel);
       pointer start = toSpaceStart[depth] != NULL ? toSpaceStart[depth] : HM_getChunkStart(toSpaceList->firstChunk);
       HM_chunk startChunk = toSpaceStartChunk[depth] != NULL ? toSpaceStartChunk[depth] : toSpaceList->firstChunk;
+      if (parallel)
+      {
+        LGC_parallelScanDepth(s, &forwardHHObjptrArgs, depth, startChunk, start);
+        continue;
+      }
       HM_forwardHHObjptrsInChunkList(
           s,
           startChunk,
@@ -640,6 +785,14 @@ void HM_HHC_collectLocal(uint32_t desiredScope)
     }
   }
 
+  if (parallel)
+  {
+    free(job->toSpaceLocal);
+    free(job->stats);
+    job->toSpaceLocal = NULL;
+    job->stats = NULL;
+  }
+
   LOG(LM_HH_COLLECTION, LL_DEBUG,
       "Copied %" PRIu64 " objects in copy-collection",
       forwardHHObjptrArgs.objectsCopied - oldObjectCopied);
@@ -675,6 +828,10 @@ void HM_HHC_collectLocal(uint32_t desiredScope)
     }
   }
 
+  LGC_processWeaks(s, &forwardHHObjptrArgs);
+  HM_freeChunksInList(s, &weaks);
+  forwardHHObjptrArgs.weaks = NULL;
+
   /* Free old chunks and find the tail (upper segment) of the original hh
    * that will be merged with the toSpace */
   HM_HierarchicalHeap hhTail = hh;
@@ -790,6 +947,20 @@ void HM_HHC_collectLocal(uint32_t desiredScope)
 
   CC_workList_free(s, &(forwardHHObjptrArgs.worklist));
 
+  if (NULL != forwardHHObjptrArgs.hashCons)
+  {
+    struct LGC_hashConsTable *t = forwardHHObjptrArgs.hashCons;
+    LOG(LM_HH_COLLECTION, LL_INFO,
+        "hash-consed %"PRIu64" objects (%zu bytes), %zu distinct",
+        t->objectsSaved,
+        t->bytesSaved,
+        t->size);
+    s->cumulativeStatistics->bytesHashConsed += t->bytesSaved;
+    s->cumulativeStatistics->numHashConsGCs++;
+    LGC_freeHashConsTable(t);
+    forwardHHObjptrArgs.hashCons = NULL;
+  }
+
   /* Build the toSpace hh */
   HM_HierarchicalHeap hhToSpace = NULL;
   for (uint32_t i = 0; i <= maxDepth; i++)
@@ -982,6 +1153,22 @@ void HM_HHC_collectLocal(uint32_t desiredScope)
   timespec_sub(&stopTime, &startTime);
   timespec_add(&(s->cumulativeStatistics->timeLocalGC), &stopTime);
 
+  HM_HH_adjustCollectionThreshold(s);
+
+  /* Run the MLton.Signal.handleGC handler (e.g., finalizers) after local
+   * collections on the primary only, so that at most one instance of the
+   * handler runs at a time. The handled flag lives on the primary. */
+  if (0 == s->procNumber && s->procStates[0].signalsInfo.gcSignalHandled)
+  {
+    s->signalsInfo.gcSignalPending = TRUE;
+    if (!s->signalsInfo.amInSignalHandler)
+    {
+      if (s->atomicState == 0)
+        s->limit = 0;
+      s->signalsInfo.signalIsPending = TRUE;
+    }
+  }
+
   // if (stopTime.tv_sec >= 1 || stopTime.tv_nsec > 999999999 / 2) {
   //   printf("[WARN] long GC %lld.%.9ld s, %d -> %d, %d\n",
   //     (long long)stopTime.tv_sec,
@@ -1015,10 +1202,309 @@ void HM_HHC_collectLocal(uint32_t desiredScope)
 
 /* ========================================================================= */
 
+struct LGC_parallelJob* LGC_newParallelJob(void)
+{
+  struct LGC_parallelJob *job =
+    (struct LGC_parallelJob *)malloc_safe(sizeof(struct LGC_parallelJob));
+  job->state = 0;
+  spinlock_init(&(job->lock));
+  job->owner = NULL;
+  job->args = NULL;
+  job->depth = 0;
+  job->maxParticipants = 0;
+  job->nextSlot = 0;
+  job->numActive = 0;
+  job->pool = NULL;
+  job->poolSize = 0;
+  job->poolCapacity = 0;
+  job->toSpaceLocal = NULL;
+  job->stats = NULL;
+  return job;
+}
+
+/* Requires that the job is closed, or that the caller holds the lock. */
+static void LGC_pushPacket(
+    struct LGC_parallelJob *job,
+    HM_chunk chunk,
+    pointer start)
+{
+  if (job->poolSize == job->poolCapacity)
+  {
+    size_t newCapacity = (0 == job->poolCapacity) ? 64 : 2 * job->poolCapacity;
+    struct LGC_scanPacket *newPool = (struct LGC_scanPacket *)
+      realloc(job->pool, newCapacity * sizeof(struct LGC_scanPacket));
+    if (NULL == newPool)
+    {
+      DIE("Ran out of space for local collection work pool!");
+    }
+    job->pool = newPool;
+    job->poolCapacity = newCapacity;
+  }
+  job->pool[job->poolSize].chunk = chunk;
+  job->pool[job->poolSize].start = start;
+  job->poolSize++;
+}
+
+/* Take a packet from the pool, waiting if necessary. Returns false once the
+ * pool is empty and nobody is active anymore, at which point no more work
+ * can appear. On success, the caller is counted as active until it
+ * decrements job->numActive. */
+static bool LGC_takePacket(
+    GC_state s,
+    struct LGC_parallelJob *job,
+    struct LGC_scanPacket *result)
+{
+  while (TRUE)
+  {
+    spinlock_lock(&(job->lock), Proc_processorNumber(s));
+    if (job->poolSize > 0)
+    {
+      job->poolSize--;
+      *result = job->pool[job->poolSize];
+      __sync_fetch_and_add(&(job->numActive), 1);
+      spinlock_unlock(&(job->lock));
+      return TRUE;
+    }
+    bool done = (0 == __atomic_load_n(&(job->numActive), __ATOMIC_ACQUIRE));
+    spinlock_unlock(&(job->lock));
+
+    if (done)
+      return FALSE;
+
+    while (0 == __atomic_load_n(&(job->poolSize), __ATOMIC_ACQUIRE) &&
+           0 != __atomic_load_n(&(job->numActive), __ATOMIC_ACQUIRE))
+    {
+      /* spin */
+    }
+  }
+}
+
+/* Scan the objects of `chunk` from `p` until the frontier. Since the
+ * frontier is reread after each object, this also picks up objects copied
+ * into the chunk while scanning it. */
+static pointer LGC_scanChunk(
+    GC_state s,
+    HM_chunk chunk,
+    pointer p,
+    struct GC_foreachObjptrClosure *closure,
+    struct ForwardHHObjptrArgs *args)
+{
+  assert(HM_getChunkStart(chunk) <= p);
+  while (p != HM_getChunkFrontier(chunk))
+  {
+    assert(p < HM_getChunkFrontier(chunk));
+    p = advanceToObjectData(s, p);
+    args->containingObject = pointerToObjptr(p, NULL);
+    /* skip weaks: see LGC_processWeaks */
+    p = foreachObjptrInObject(s,
+                              p,
+                              &trueObjptrPredicateClosure,
+                              closure,
+                              TRUE);
+  }
+  args->containingObject = BOGUS_OBJPTR;
+  return p;
+}
+
+struct LGC_participant
+{
+  struct ForwardHHObjptrArgs args;
+  /* Cheney-style scan position in args.toSpaceLocal[job->depth] */
+  HM_chunk scanChunk;
+  pointer scanPtr;
+};
+
+/* Scan everything this participant copied at the current depth. Whenever
+ * there are complete chunks that this participant has not yet started
+ * scanning, give them away to the pool and continue at the last chunk. */
+static void LGC_drainLocal(
+    GC_state s,
+    struct LGC_participant *part,
+    struct GC_foreachObjptrClosure *closure)
+{
+  struct LGC_parallelJob *job = part->args.job;
+  HM_chunkList list = &(part->args.toSpaceLocal[job->depth]);
+
+  while (TRUE)
+  {
+    if (NULL == part->scanChunk)
+    {
+      if (NULL == list->firstChunk)
+        return;
+      part->scanChunk = list->firstChunk;
+      part->scanPtr = HM_getChunkStart(list->firstChunk);
+    }
+
+    part->scanPtr =
+      LGC_scanChunk(s, part->scanChunk, part->scanPtr, closure, &(part->args));
+
+    HM_chunk next = part->scanChunk->nextChunk;
+    if (NULL == next)
+      return;
+
+    /* Only the last chunk can still grow, so the others can be shared. */
+    HM_chunk last = HM_getChunkListLastChunk(list);
+    if (next != last)
+    {
+      spinlock_lock(&(job->lock), Proc_processorNumber(s));
+      for (HM_chunk chunk = next; chunk != last; chunk = chunk->nextChunk)
+        LGC_pushPacket(job, chunk, HM_getChunkStart(chunk));
+      spinlock_unlock(&(job->lock));
+    }
+
+    part->scanChunk = last;
+    part->scanPtr = HM_getChunkStart(last);
+  }
+}
+
+void LGC_participate(GC_state s, struct LGC_parallelJob *job, uint32_t slot)
+{
+  assert(slot < job->maxParticipants);
+
+  struct LGC_participant part;
+  part.args = *(job->args);
+  part.args.job = job;
+  part.args.hashCons = NULL;
+  part.args.toSpaceLocal =
+    &(job->toSpaceLocal[(size_t)slot * (job->args->maxDepth + 1)]);
+  part.args.containingObject = BOGUS_OBJPTR;
+  part.args.bytesCopied = 0;
+  part.args.objectsCopied = 0;
+  part.args.stacksCopied = 0;
+  part.args.bytesMoved = 0;
+  part.args.objectsMoved = 0;
+  part.scanChunk = NULL;
+  part.scanPtr = NULL;
+
+  struct GC_foreachObjptrClosure closure =
+    {.fun = forwardHHObjptr, .env = &(part.args)};
+
+  struct LGC_participantStats *stats = &(job->stats[slot]);
+  struct LGC_scanPacket packet;
+  struct timespec startTime;
+  struct timespec stopTime;
+
+  while (LGC_takePacket(s, job, &packet))
+  {
+    timespec_now(&startTime);
+    LGC_scanChunk(s, packet.chunk, packet.start, &closure, &(part.args));
+    LGC_drainLocal(s, &part, &closure);
+    timespec_now(&stopTime);
+    timespec_sub(&stopTime, &startTime);
+    timespec_add(&(stats->timeBusy), &stopTime);
+    __sync_fetch_and_sub(&(job->numActive), 1);
+  }
+
+  stats->bytesCopied = part.args.bytesCopied;
+  stats->bytesMoved = part.args.bytesMoved;
+  stats->objectsCopied = part.args.objectsCopied;
+  stats->objectsMoved = part.args.objectsMoved;
+  stats->stacksCopied = part.args.stacksCopied;
+}
+
+void LGC_parallelScanDepth(
+    GC_state s,
+    struct ForwardHHObjptrArgs *args,
+    uint32_t depth,
+    HM_chunk startChunk,
+    pointer start)
+{
+  struct LGC_parallelJob *job = s->lgcJob;
+  assert(0 == job->state);
+  assert(NULL != job->toSpaceLocal);
+  assert(NULL == args->job);
+
+  struct timespec startTime;
+  struct timespec stopTime;
+  timespec_now(&startTime);
+
+  /* seed the pool with the unscanned part of the to-space */
+  job->poolSize = 0;
+  LGC_pushPacket(job, startChunk, start);
+  for (HM_chunk chunk = startChunk->nextChunk;
+       NULL != chunk;
+       chunk = chunk->nextChunk)
+  {
+    LGC_pushPacket(job, chunk, HM_getChunkStart(chunk));
+  }
+
+  for (uint32_t i = 0; i < job->maxParticipants; i++)
+  {
+    job->stats[i].bytesCopied = 0;
+    job->stats[i].bytesMoved = 0;
+    job->stats[i].objectsCopied = 0;
+    job->stats[i].objectsMoved = 0;
+    job->stats[i].stacksCopied = 0;
+    job->stats[i].timeBusy.tv_sec = 0;
+    job->stats[i].timeBusy.tv_nsec = 0;
+  }
+
+  job->owner = s;
+  job->args = args;
+  job->depth = depth;
+  job->numActive = 0;
+  job->nextSlot = 1;
+  __atomic_store_n(&(job->state), LGC_JOB_OPEN, __ATOMIC_SEQ_CST);
+  /* seq-cst store: pairs with the check in the scheduler's park, so either
+   * the parking worker sees the job or we see it as a sleeper and wake it */
+  Parallel_idleWakeOne();
+
+  LGC_participate(s, job, 0);
+
+  /* close the job and wait for the helpers to detach */
+  __sync_fetch_and_and(&(job->state), ~LGC_JOB_OPEN);
+  while (0 != __atomic_load_n(&(job->state), __ATOMIC_ACQUIRE))
+  {
+    /* spin */
+  }
+  assert(0 == job->poolSize);
+  assert(0 == job->numActive);
+
+  uint32_t numParticipants = min(job->nextSlot, job->maxParticipants);
+
+  /* put everything that was copied into the to-space */
+  for (uint32_t i = 0; i < numParticipants; i++)
+  {
+    HM_chunkList lists = &(job->toSpaceLocal[(size_t)i * (args->maxDepth + 1)]);
+    for (uint32_t d = args->minDepth; d <= depth; d++)
+    {
+      if (NULL == lists[d].firstChunk)
+        continue;
+      assert(NULL != args->toSpace[d]);
+      HM_appendChunkList(HM_HH_getChunkList(args->toSpace[d]), &(lists[d]));
+      HM_initChunkList(&(lists[d]));
+    }
+
+    struct LGC_participantStats *stats = &(job->stats[i]);
+    args->bytesCopied += stats->bytesCopied;
+    args->bytesMoved += stats->bytesMoved;
+    args->objectsCopied += stats->objectsCopied;
+    args->objectsMoved += stats->objectsMoved;
+    args->stacksCopied += stats->stacksCopied;
+    timespec_add(&(s->cumulativeStatistics->timeLocalGCParallelWork),
+                 &(stats->timeBusy));
+  }
+
+  LOG(LM_HH_COLLECTION, LL_DEBUG,
+      "parallel scan of level %u with %u participants",
+      depth,
+      numParticipants);
+
+  s->cumulativeStatistics->numLocalGCHelpers += numParticipants - 1;
+  timespec_now(&stopTime);
+  timespec_sub(&stopTime, &startTime);
+  timespec_add(&(s->cumulativeStatistics->timeLocalGCParallelScan), &stopTime);
+}
+
+/* ========================================================================= */
+
 bool isObjptrInToSpace(objptr op, struct ForwardHHObjptrArgs *args)
 {
   HM_chunk c = HM_getChunkOf(objptrToPointer(op, NULL));
-  HM_HierarchicalHeap levelHead = HM_getLevelHeadPathCompress(c);
+  /* No path compression during a parallel collection, because it could race
+   * with another participant moving this chunk into the to-space. */
+  HM_HierarchicalHeap levelHead =
+    (NULL == args->job) ? HM_getLevelHeadPathCompress(c) : HM_getLevelHead(c);
   uint32_t depth = HM_HH_getDepth(levelHead);
   // assert(depth <= args->maxDepth);
   assert(NULL != levelHead);
@@ -1028,6 +1514,322 @@ bool isObjptrInToSpace(objptr op, struct ForwardHHObjptrArgs *args)
 
 /* ========================================================================= */
 
+/* Weak objects are copied like any other object, but the to-space scan
+ * does not follow their objptr (see HM_forwardHHObjptrsInChunkList).
+ * Instead, relocateObject records each copy in args->weaks, and once
+ * everything reachable has been forwarded, this updates them: a weak whose
+ * target was forwarded now points to the copy, and a weak whose target was
+ * in the from-space but was not forwarded (and so is about to be freed) is
+ * cleared. Targets outside of the scope of the collection, and targets
+ * that stay in place (large objects whose chunk was moved, pinned or marked
+ * objects), are kept as they are. An object that merely shares a pinned
+ * chunk is not kept alive by that, so a weak pointing to it is cleared.
+ *
+ * Weak objects that stay pinned are recorded by LGC_markAndScan and
+ * processed the same way; their targets are not traced either. Once the
+ * depth they are pinned at is collected, they are unpinned and copied like
+ * any other weak. */
+static void LGC_recordWeak(GC_state s, struct ForwardHHObjptrArgs *args, objptr op)
+{
+  if (NULL == args->weaks)
+    return;
+  if (NULL != args->job)
+    spinlock_lock(&(args->job->lock), Proc_processorNumber(s));
+  HM_storeInChunkList(args->weaks, &op, sizeof(objptr));
+  if (NULL != args->job)
+    spinlock_unlock(&(args->job->lock));
+}
+
+static void LGC_processWeaks(GC_state s, struct ForwardHHObjptrArgs *args)
+{
+  size_t numCleared = 0;
+  size_t numUpdated = 0;
+
+  for (HM_chunk chunk = HM_getChunkListFirstChunk(args->weaks);
+       NULL != chunk;
+       chunk = chunk->nextChunk)
+  {
+    for (pointer cursor = HM_getChunkStart(chunk);
+         cursor < HM_getChunkFrontier(chunk);
+         cursor += sizeof(objptr))
+    {
+      pointer w = objptrToPointer(*((objptr *)cursor), NULL);
+      uint16_t numObjptrs;
+      splitHeader(s, getHeader(w), NULL, NULL, NULL, &numObjptrs);
+      if (0 == numObjptrs)
+        continue; /* already gone */
+
+      GC_weak weak = (GC_weak)(w + offsetofWeak(s));
+      objptr op = weak->objptr;
+      if (!isObjptr(op) || isObjptrInRootHeap(s, op))
+        continue;
+
+      uint32_t opDepth = HM_getObjptrDepth(op);
+      if (opDepth > args->maxDepth || opDepth < args->minDepth)
+        continue;
+      if (isObjptrInToSpace(op, args))
+        continue;
+
+      pointer p = objptrToPointer(op, NULL);
+      HM_chunk opChunk = HM_getChunkOf(p);
+      if (HM_getLevelHead(opChunk) != args->fromSpace[opDepth])
+        continue;
+
+      if (hasFwdPtr(p))
+      {
+        weak->objptr = getFwdPtr(p);
+        numUpdated++;
+      }
+      else if (!isPinned(op) && !CC_isPointerMarked(p) && tryClearWeak(s, w))
+      {
+        numCleared++;
+      }
+    }
+  }
+
+  if (numCleared + numUpdated > 0)
+  {
+    LOG(LM_HH_COLLECTION, LL_DEBUG,
+        "weaks: %zu updated, %zu cleared",
+        numUpdated,
+        numCleared);
+  }
+  s->cumulativeStatistics->numWeaksCleared += numCleared;
+}
+
+/* ========================================================================= */
+
+/* Stacks live in chunks of their own, which relocateObject normally moves
+ * to the to-space as they are. A suspended stack that once grew deep would
+ * then keep its full reservation forever, so instead, if the stack of a
+ * suspended thread can shrink (see sizeofStackShrinkReserved) enough to
+ * free at least one block, this copies it into a new, smaller chunk and
+ * leaves the old chunk in the from-space to be freed.
+ *
+ * A stack that is seen by stackHibernateCollections consecutive collections
+ * with the same used size is assumed to be long-suspended (e.g., the
+ * continuation of a stolen task waiting on a join) and is compacted to its
+ * used size. It grows again as usual when resumed.
+ *
+ * Returns the new stack, or BOGUS_OBJPTR if the stack should just be moved.
+ * In a parallel collection, the caller holds args->job->lock. */
+static objptr LGC_shrinkStack(GC_state s,
+                              struct ForwardHHObjptrArgs *args,
+                              pointer p,
+                              HM_HierarchicalHeap tgtHeap,
+                              HM_chunkList tgtChunkList)
+{
+  GC_stack stack = (GC_stack)p;
+  if (!s->controls->shrinkStacks || args->concurrent || p == args->currentStack)
+    return BOGUS_OBJPTR;
+
+  if (stack->used == stack->lastUsed)
+  {
+    stack->suspendedCollections++;
+  }
+  else
+  {
+    stack->lastUsed = stack->used;
+    stack->suspendedCollections = 0;
+  }
+
+  bool hibernate =
+    0 != s->controls->stackHibernateCollections
+    && stack->suspendedCollections >= s->controls->stackHibernateCollections;
+  size_t reservedNew =
+    hibernate
+    ? alignStackReserved(s, stack->used)
+    : sizeofStackShrinkReserved(s, stack, FALSE);
+  assert(stack->used <= reservedNew);
+  if (reservedNew >= stack->reserved)
+    return BOGUS_OBJPTR;
+
+  HM_chunk chunk = HM_getChunkOf(p);
+  size_t stackSize = sizeofStackWithMetaData(s, reservedNew);
+  size_t newChunkSize =
+    align(stackSize + sizeof(struct HM_chunk), s->controls->blockSize);
+  if (newChunkSize + s->controls->blockSize > HM_getChunkSize(chunk))
+    return BOGUS_OBJPTR;
+
+  HM_chunk newChunk = HM_allocateChunkWithPurpose(
+    tgtChunkList,
+    stackSize,
+    BLOCK_FOR_HEAP_CHUNK);
+  if (NULL == newChunk)
+  {
+    DIE("Ran out of space to shrink stack!");
+  }
+  newChunk->mightContainMultipleObjects = FALSE;
+  newChunk->levelHead = HM_HH_getUFNode(tgtHeap);
+  newChunk->decheckState = chunk->decheckState;
+
+  pointer frontier = HM_getChunkFrontier(newChunk);
+  assert(GC_STACK_METADATA_SIZE == GC_HEADER_SIZE);
+  *((GC_header*)frontier) = GC_STACK_HEADER;
+  GC_stack newStack = (GC_stack)(frontier + GC_HEADER_SIZE);
+  newStack->reserved = reservedNew;
+  newStack->lastUsed = stack->lastUsed;
+  newStack->suspendedCollections = stack->suspendedCollections;
+  copyStack(s, stack, newStack);
+  moveStackSporkFrames(stack, newStack);
+  HM_updateChunkFrontierInList(tgtChunkList, newChunk, frontier + stackSize);
+
+  objptr newPointer = pointerToObjptr((pointer)newStack, NULL);
+  *(getFwdPtrp(p)) = newPointer;
+
+  LOG(LM_HH_COLLECTION, LL_DEBUG,
+      "%s stack of size %s bytes to size %s bytes, using %s bytes.",
+      hibernate ? "Compacting" : "Shrinking",
+      uintmaxToCommaString(stack->reserved),
+      uintmaxToCommaString(reservedNew),
+      uintmaxToCommaString(stack->used));
+
+  s->cumulativeStatistics->numStacksShrunk++;
+  if (hibernate)
+    s->cumulativeStatistics->numStacksHibernated++;
+  s->cumulativeStatistics->bytesReclaimedFromStacks +=
+    HM_getChunkSize(chunk) - HM_getChunkSize(newChunk);
+  /* stands in for the copy in relocateObject; the callers of relocateObject
+   * count stacksCopied */
+  args->bytesCopied += stackSize;
+  args->objectsCopied++;
+  return newPointer;
+}
+
+/* ========================================================================= */
+
+static struct LGC_hashConsTable *LGC_newHashConsTable(void)
+{
+  struct LGC_hashConsTable *t = malloc_safe(sizeof(struct LGC_hashConsTable));
+  t->capacity = 1024;
+  t->size = 0;
+  t->elements = calloc_safe(t->capacity, sizeof(struct LGC_hashConsElement));
+  for (size_t i = 0; i < t->capacity; i++)
+    t->elements[i].object = BOGUS_OBJPTR;
+  t->bytesSaved = 0;
+  t->objectsSaved = 0;
+  return t;
+}
+
+static void LGC_freeHashConsTable(struct LGC_hashConsTable *t)
+{
+  free(t->elements);
+  free(t);
+}
+
+/* The bytes of p that make up its value: the payload of a normal object, or
+ * the elements of a sequence (without the padding after them, which is not
+ * initialized). Returns FALSE if p can't be hash-consed. */
+static bool hashConsPayload(
+  GC_state s,
+  GC_header header,
+  pointer p,
+  GC_objectTypeTag *tagRet,
+  size_t *bytesRet)
+{
+  GC_objectTypeTag tag;
+  bool hasIdentity;
+  uint16_t bytesNonObjptrs;
+  uint16_t numObjptrs;
+  splitHeader(s, header, &tag, &hasIdentity, &bytesNonObjptrs, &numObjptrs);
+
+  if (hasIdentity || numObjptrs > 0)
+    return FALSE;
+  if (NORMAL_TAG == tag)
+    *bytesRet = bytesNonObjptrs;
+  else if (SEQUENCE_TAG == tag)
+    *bytesRet = (size_t)getSequenceLength(p) * bytesNonObjptrs;
+  else
+    return FALSE;
+  *tagRet = tag;
+  return TRUE;
+}
+
+static uint64_t hashConsHash(GC_header header, pointer p, size_t bytes)
+{
+  uint64_t h = 0xcbf29ce484222325ULL ^ (uint64_t)header ^ ((uint64_t)bytes << 32);
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= bytes; i += sizeof(uint64_t))
+  {
+    uint64_t w;
+    memcpy(&w, p + i, sizeof(uint64_t));
+    h = (h ^ w) * 0x100000001b3ULL;
+    h ^= h >> 29;
+  }
+  for (; i < bytes; i++)
+    h = (h ^ p[i]) * 0x100000001b3ULL;
+  return h ^ (h >> 32);
+}
+
+static void hashConsGrow(struct LGC_hashConsTable *t)
+{
+  struct LGC_hashConsElement *old = t->elements;
+  size_t oldCapacity = t->capacity;
+
+  t->capacity = 2 * oldCapacity;
+  t->elements = calloc_safe(t->capacity, sizeof(struct LGC_hashConsElement));
+  for (size_t i = 0; i < t->capacity; i++)
+    t->elements[i].object = BOGUS_OBJPTR;
+
+  size_t mask = t->capacity - 1;
+  for (size_t i = 0; i < oldCapacity; i++)
+  {
+    if (BOGUS_OBJPTR == old[i].object)
+      continue;
+    size_t j = old[i].hash & mask;
+    while (BOGUS_OBJPTR != t->elements[j].object)
+      j = (j + 1) & mask;
+    t->elements[j] = old[i];
+  }
+  free(old);
+}
+
+/* Look for a copy of the from-space object p among the objects already
+ * copied to `depth`. If there is none, returns BOGUS_OBJPTR and sets
+ * *slotRet, for hashConsInsert after p has been copied. */
+static objptr hashConsLookup(
+  GC_state s,
+  struct LGC_hashConsTable *t,
+  GC_header header,
+  pointer p,
+  uint32_t depth,
+  struct LGC_hashConsElement **slotRet)
+{
+  GC_objectTypeTag tag;
+  size_t bytes;
+  *slotRet = NULL;
+  if (!hashConsPayload(s, header, p, &tag, &bytes))
+    return BOGUS_OBJPTR;
+
+  if (2 * (t->size + 1) > t->capacity)
+    hashConsGrow(t);
+
+  uint64_t hash = hashConsHash(header, p, bytes);
+  size_t mask = t->capacity - 1;
+  size_t j = hash & mask;
+  while (BOGUS_OBJPTR != t->elements[j].object)
+  {
+    struct LGC_hashConsElement *e = &(t->elements[j]);
+    if (e->hash == hash && e->depth == depth)
+    {
+      pointer q = objptrToPointer(e->object, NULL);
+      if (getHeader(q) == header
+          && (NORMAL_TAG == tag
+              || getSequenceLength(q) == getSequenceLength(p))
+          && 0 == memcmp(q, p, bytes))
+        return e->object;
+    }
+    j = (j + 1) & mask;
+  }
+
+  t->elements[j].hash = hash;
+  t->elements[j].depth = depth;
+  *slotRet = &(t->elements[j]);
+  return BOGUS_OBJPTR;
+}
+
+/* ========================================================================= */
+
 objptr relocateObject(
     GC_state s,
     objptr op,
@@ -1037,9 +1839,14 @@ objptr relocateObject(
 {
   *relocSuccess = true;
   pointer p = objptrToPointer(op, NULL);
-  assert(!hasFwdPtr(p));
   assert(HM_HH_isLevelHead(tgtHeap));
   GC_header header = getHeader(p);
+
+  if (NULL != args->job && isFwdHeader(header))
+  {
+    /* another participant of a parallel collection got here first */
+    return getFwdPtr(p);
+  }
   assert (!isFwdHeader(header));
 
   if (pinType(header) != PIN_NONE)
@@ -1051,28 +1858,65 @@ objptr relocateObject(
     return op;
   }
 
-  HM_chunkList tgtChunkList = HM_HH_getChunkList(tgtHeap);
+  /* In a parallel collection, each participant copies into its own
+   * chunklist, which is spliced into the tgtHeap afterwards. */
+  HM_chunkList tgtChunkList =
+    (NULL == args->toSpaceLocal)
+    ? HM_HH_getChunkList(tgtHeap)
+    : &(args->toSpaceLocal[HM_HH_getDepth(tgtHeap)]);
 
   size_t metaDataBytes;
   size_t objectBytes;
   size_t copyBytes;
 
   /* compute object size and bytes to be copied */
-  computeObjectCopyParameters(s,
-                              header,
-                              p,
-                              &objectBytes,
-                              &copyBytes,
-                              &metaDataBytes);
+  GC_objectTypeTag tag =
+    computeObjectCopyParameters(s,
+                                header,
+                                p,
+                                &objectBytes,
+                                &copyBytes,
+                                &metaDataBytes);
 
   if (!HM_getChunkOf(p)->mightContainMultipleObjects)
   {
     /* This chunk contains *only* this object, so no need to copy. Instead,
      * just move the chunk. Don't forget to update the levelHead, too! */
     HM_chunk chunk = HM_getChunkOf(p);
+    if (NULL != args->job)
+    {
+      /* The from-space chunklist is shared by all participants, and some
+       * other participant might have just moved this same chunk. */
+      spinlock_lock(&(args->job->lock), Proc_processorNumber(s));
+      if (chunk->levelHead == HM_HH_getUFNode(tgtHeap))
+      {
+        spinlock_unlock(&(args->job->lock));
+        return op;
+      }
+      if (hasFwdPtr(p))
+      {
+        /* ...or copied it into a smaller chunk (see LGC_shrinkStack) */
+        spinlock_unlock(&(args->job->lock));
+        return getFwdPtr(p);
+      }
+    }
+    if (STACK_TAG == tag)
+    {
+      objptr shrunk = LGC_shrinkStack(s, args, p, tgtHeap, tgtChunkList);
+      if (BOGUS_OBJPTR != shrunk)
+      {
+        if (NULL != args->job)
+          spinlock_unlock(&(args->job->lock));
+        return shrunk;
+      }
+    }
     HM_unlinkChunkPreserveLevelHead(HM_HH_getChunkList(HM_getLevelHead(chunk)), chunk);
     HM_appendChunk(tgtChunkList, chunk);
     chunk->levelHead = HM_HH_getUFNode(tgtHeap);
+    if (NULL != args->job)
+    {
+      spinlock_unlock(&(args->job->lock));
+    }
 
     LOG(LM_HH_COLLECTION, LL_DEBUGMORE,
         "Moved single-object chunk %p of size %zu",
@@ -1080,18 +1924,49 @@ objptr relocateObject(
         HM_getChunkSize(chunk));
     args->bytesMoved += copyBytes;
     args->objectsMoved++;
+    if (WEAK_TAG == tag)
+      LGC_recordWeak(s, args, op);
     return op;
   }
 
+  struct LGC_hashConsElement *hashConsSlot = NULL;
+  if (NULL != args->hashCons && NULL == args->job && !args->concurrent)
+  {
+    objptr copy = hashConsLookup(s, args->hashCons, header, p,
+                                 HM_HH_getDepth(tgtHeap), &hashConsSlot);
+    if (BOGUS_OBJPTR != copy)
+    {
+      *(getFwdPtrp(p)) = copy;
+      args->hashCons->bytesSaved += objectBytes + metaDataBytes;
+      args->hashCons->objectsSaved++;
+      return copy;
+    }
+  }
+
   /* Otherwise try copying the object */
-  pointer copyPointer = copyObject(p - metaDataBytes,
-                                   objectBytes,
-                                   copyBytes,
-                                   tgtHeap);
+  pointer copyPointer = copyObjectIntoList(p - metaDataBytes,
+                                           objectBytes,
+                                           copyBytes,
+                                           tgtHeap,
+                                           tgtChunkList);
 
   /* Store the forwarding pointer in the old object metadata. */
   objptr newPointer = pointerToObjptr(copyPointer + metaDataBytes, NULL);
-  if (!args->concurrent)
+  if (NULL != args->job)
+  {
+    if (!__sync_bool_compare_and_swap(getFwdPtrp(p), header, newPointer))
+    {
+      /* Lost the race against another participant. Nobody else can modify
+       * the header of an unpinned object during the collection. */
+      delLastObj(newPointer, objectBytes, tgtChunkList);
+      if (!hasFwdPtr(p))
+      {
+        DIE("header of " FMTOBJPTR " changed unexpectedly during parallel collection", op);
+      }
+      return getFwdPtr(p);
+    }
+  }
+  else if (!args->concurrent)
   {
     assert(!isPinned(op));
     assert (__sync_bool_compare_and_swap(getFwdPtrp(p), header, newPointer));
@@ -1102,7 +1977,7 @@ objptr relocateObject(
     bool success = __sync_bool_compare_and_swap(getFwdPtrp(p), header, newPointer);
     if (!success)
     {
-      delLastObj(newPointer, objectBytes, tgtHeap);
+      delLastObj(newPointer, objectBytes, tgtChunkList);
       assert(isPinned(op));
       *relocSuccess = false;
       return op;
@@ -1111,6 +1986,15 @@ objptr relocateObject(
   assert (getFwdPtr(p) == newPointer);
   assert(hasFwdPtr(p));
 
+  if (NULL != hashConsSlot)
+  {
+    hashConsSlot->object = newPointer;
+    args->hashCons->size++;
+  }
+
+  if (WEAK_TAG == tag)
+    LGC_recordWeak(s, args, newPointer);
+
   args->bytesCopied += copyBytes;
   args->objectsCopied++;
 
@@ -1380,6 +2264,11 @@ void LGC_markAndScan(
     HM_appendChunk(&(args->pinned[opDepth]), chunk);
   }
 
+  GC_objectTypeTag tag;
+  splitHeader(s, getHeader(p), &tag, NULL, NULL, NULL);
+  if (WEAK_TAG == tag)
+    LGC_recordWeak(s, args, op);
+
   CC_workList_push(s, &(args->worklist), op);
   struct GC_foreachObjptrClosure markClosure =
       {.fun = markAndAdd, .env = (void *)args};
@@ -1671,7 +2560,8 @@ void forwardHHObjptr(
     return;
   }
 
-  uint32_t opDepth = HM_getObjptrDepthPathCompress(op);
+  uint32_t opDepth =
+    (NULL == args->job) ? HM_getObjptrDepthPathCompress(op) : HM_getObjptrDepth(op);
 
   // if (opDepth > args->maxDepth)
   // {
@@ -1714,6 +2604,66 @@ void forwardHHObjptr(
     return;
   }
 
+  if (NULL != args->job)
+  {
+    /* Parallel collection: other participants might concurrently unpin or
+     * forward this object, so every decision has to be made on a single
+     * snapshot of the header. */
+    GC_header header = getHeader(p);
+    while (!isFwdHeader(header))
+    {
+      if (MARK_MASK == (header & MARK_MASK))
+      {
+        // this object is collected in-place.
+        return;
+      }
+      if (PIN_NONE == pinType(header))
+        break;
+      if (unpinDepthOfH(header) < opDepth)
+      {
+        // This is a truly pinned object
+        return;
+      }
+
+      /* Lazily unpin (see below). If this fails, somebody else either
+       * unpinned or forwarded the object in the meantime. */
+      GC_header newHeader = header & (~UNPIN_DEPTH_MASK) & (~PIN_MASK);
+      __sync_bool_compare_and_swap(getHeaderp(p), header, newHeader);
+      header = getHeader(p);
+    }
+
+    if (isFwdHeader(header))
+    {
+      objptr fop = getFwdPtr(p);
+      assert(isObjptrInToSpace(fop, args));
+      *opp = fop;
+      return;
+    }
+
+    GC_objectTypeTag tag;
+    size_t metaDataBytes;
+    size_t objectBytes;
+    size_t copyBytes;
+    tag = computeObjectCopyParameters(s,
+                                      header,
+                                      p,
+                                      &objectBytes,
+                                      &copyBytes,
+                                      &metaDataBytes);
+    HM_HierarchicalHeap tgtHeap = toSpaceHH(s, args, opDepth);
+    uint64_t oldMoved = args->objectsMoved;
+    uint64_t oldCopied = args->objectsCopied;
+    bool relocateSuccess;
+    *opp = relocateObject(s, op, tgtHeap, args, &relocateSuccess);
+    assert(relocateSuccess);
+    if (STACK_TAG == tag &&
+        (args->objectsMoved != oldMoved || args->objectsCopied != oldCopied))
+    {
+      args->stacksCopied++;
+    }
+    return;
+  }
+
   if (hasFwdPtr(p))
   {
     objptr fop = getFwdPtr(p);
@@ -1790,11 +2740,6 @@ void forwardHHObjptr(
     case STACK_TAG:
       args->stacksCopied++;
       break;
-    case WEAK_TAG:
-      die(__FILE__ ":%d: "
-                   "forwardHHObjptr() does not support WEAK_TAG objects!",
-          __LINE__);
-      break;
     default:
       break;
     }
@@ -1820,14 +2765,25 @@ pointer copyObject(pointer p,
                    size_t copySize,
                    HM_HierarchicalHeap tgtHeap)
 {
+  return copyObjectIntoList(p,
+                            objectSize,
+                            copySize,
+                            tgtHeap,
+                            HM_HH_getChunkList(tgtHeap));
+}
+
+pointer copyObjectIntoList(pointer p,
+                           size_t objectSize,
+                           size_t copySize,
+                           HM_HierarchicalHeap tgtHeap,
+                           HM_chunkList tgtChunkList)
+{
 
   // check if you can add to existing chunk --> mightContain + size
   // If not, allocate new chunk and copy.
 
   assert(HM_HH_isLevelHead(tgtHeap));
   assert(copySize <= objectSize);
-
-  HM_chunkList tgtChunkList = HM_HH_getChunkList(tgtHeap);
   assert(NULL != tgtChunkList);
 
   /* get the chunk to allocate in */
@@ -1882,9 +2838,8 @@ pointer copyObject(pointer p,
   return frontier;
 }
 
-void delLastObj(objptr op, size_t objectSize, HM_HierarchicalHeap tgtHeap)
+void delLastObj(objptr op, size_t objectSize, HM_chunkList tgtChunkList)
 {
-  HM_chunkList tgtChunkList = HM_HH_getChunkList(tgtHeap);
   HM_chunk chunk = HM_getChunkOf(objptrToPointer(op, NULL));
   assert(listContainsChunk(tgtChunkList, chunk));
   HM_updateChunkFrontierInList(tgtChunkList, chunk, HM_getChunkFrontier(chunk) - objectSize);
@@ -1907,13 +2862,6 @@ GC_objectTypeTag computeObjectCopyParameters(GC_state s,
   /* Compute the space taken by the metadata and object body. */
   if ((NORMAL_TAG == tag) or (WEAK_TAG == tag))
   { /* Fixed size object. */
-    if (WEAK_TAG == tag)
-    {
-      die(__FILE__ ":%d: "
-                   "computeObjectSizeAndCopySize() #define does not support"
-                   " WEAK_TAG objects!",
-          __LINE__);
-    }
     *metaDataSize = GC_NORMAL_METADATA_SIZE;
     *objectSize = bytesNonObjptrs + (numObjptrs * OBJPTR_SIZE);
     *copySize = *objectSize;
@@ -1928,35 +2876,14 @@ GC_objectTypeTag computeObjectCopyParameters(GC_state s,
   else
   {
     /* Stack. */
-    // bool current;
-    // size_t reservedNew;
     GC_stack stack;
 
     assert(STACK_TAG == tag);
     *metaDataSize = GC_STACK_METADATA_SIZE;
     stack = (GC_stack)p;
 
-    /* SAM_NOTE:
-     * I am disabling shrinking here because it assumes that
-     * the stack is going to be copied, which doesn't work with the
-     * "stacks-in-their-own-chunks" strategy.
-     */
-#if 0
-      /* RAM_NOTE: This changes with non-local collection */
-      /* Check if the pointer is the current stack of my processor. */
-      current = getStackCurrent(s) == stack;
-
-      reservedNew = sizeofStackShrinkReserved (s, stack, current);
-      if (reservedNew < stack->reserved) {
-        LOG(LM_HH_COLLECTION, LL_DEBUG,
-            "Shrinking stack of size %s bytes to size %s bytes"
-            ", using %s bytes.",
-            uintmaxToCommaString(stack->reserved),
-            uintmaxToCommaString(reservedNew),
-            uintmaxToCommaString(stack->used));
-        stack->reserved = reservedNew;
-      }
-#endif
+    /* Stacks live in their own chunks and are moved, not copied, so
+     * shrinking happens in relocateObject instead (see LGC_shrinkStack). */
     *objectSize = sizeof(struct GC_stack) + stack->reserved;
     *copySize = sizeof(struct GC_stack) + stack->used;
   }
@@ -21,6 +21,32 @@
 #include "cc-work-list.h"
 
 #if (defined(MLTON_GC_INTERNAL_TYPES))
+struct LGC_parallelJob;
+
+/* Hash-consing during local collections (see GC_setHashConsDuringGC).
+ * While objects are copied into the to-space, immutable objects without
+ * identity and without objptr fields (strings and other vectors of scalars,
+ * tuples of scalars) are looked up among the objects already copied to the
+ * same depth by this collection, and forwarded to an equal copy if there is
+ * one. Objects with objptr fields are not hash-consed: when they are copied,
+ * their fields still point into the from-space, so equality can't be
+ * decided yet. */
+struct LGC_hashConsElement
+{
+  uint64_t hash;
+  objptr object; /* BOGUS_OBJPTR if the slot is empty */
+  uint32_t depth;
+};
+
+struct LGC_hashConsTable
+{
+  struct LGC_hashConsElement *elements;
+  size_t capacity; /* a power of two */
+  size_t size;
+  size_t bytesSaved;
+  uint64_t objectsSaved;
+};
+
 struct ForwardHHObjptrArgs
 {
   struct HM_HierarchicalHeap *hh;
@@ -51,8 +77,85 @@ struct ForwardHHObjptrArgs
   /*worklist for mark and scan*/
   struct CC_workList worklist;
   bool concurrent;
+
+  /* NULL unless hash-consing; never used in a parallel collection. */
+  struct LGC_hashConsTable *hashCons;
+
+  /* The stack of the thread being collected, which is never shrunk. */
+  pointer currentStack;
+
+  /* The to-space copies of weak objects (see LGC_processWeaks). Shared by
+   * all participants of a parallel collection, under job->lock. */
+  struct HM_chunkList *weaks;
+
+  /* Only set while participating in a parallel local collection (see
+   * struct LGC_parallelJob). In that case, objects are copied into
+   * toSpaceLocal[depth], a private chunklist of this participant, rather
+   * than directly into the chunklist of toSpace[depth]. */
+  struct LGC_parallelJob *job;
+  struct HM_chunkList *toSpaceLocal;
 };
 
+/* A unit of work in a parallel local collection: all objects of `chunk`
+ * from `start` up to the chunk's frontier still need to be scanned. The
+ * chunk is complete (no more objects will be copied into it), so the range
+ * is fixed. */
+struct LGC_scanPacket
+{
+  HM_chunk chunk;
+  pointer start;
+};
+
+struct LGC_participantStats
+{
+  size_t bytesCopied;
+  size_t bytesMoved;
+  uint64_t objectsCopied;
+  uint64_t objectsMoved;
+  uint64_t stacksCopied;
+  struct timespec timeBusy;
+};
+
+/* Every processor owns one of these (s->lgcJob), used to invite idle
+ * processors to help with the scan phase of its local collections. The
+ * scan proceeds one depth at a time (deepest first); for each depth, the
+ * collector opens the job, and all participants (the collector plus any
+ * helpers that manage to join) take packets from the shared pool. Each
+ * participant copies into its own private to-space chunklists, and
+ * publishes completed chunks back into the pool so that others can scan
+ * them. Once the pool is empty and no participant is active, the collector
+ * closes the job, waits for helpers to detach, and splices the private
+ * chunklists into the to-space.
+ *
+ * The job itself is never freed, so a helper can always safely inspect the
+ * state of another processor's job. */
+struct LGC_parallelJob
+{
+  /* LGC_JOB_OPEN bit, plus the number of helpers currently attached */
+  volatile uint32_t state;
+
+  /* protects the pool, and also moves of single-object chunks */
+  spinlock_t lock;
+
+  GC_state owner;                   /* the collecting processor */
+  struct ForwardHHObjptrArgs *args; /* the collector's arguments */
+  uint32_t depth;                   /* depth currently being scanned */
+  uint32_t maxParticipants;         /* including the collector (slot 0) */
+  volatile uint32_t nextSlot;
+  volatile uint32_t numActive;
+
+  struct LGC_scanPacket *pool;
+  volatile size_t poolSize;
+  size_t poolCapacity;
+
+  /* maxParticipants * (args->maxDepth+1) chunklists, indexed by slot and
+   * then by depth */
+  struct HM_chunkList *toSpaceLocal;
+  struct LGC_participantStats *stats;
+};
+
+#define LGC_JOB_OPEN ((uint32_t)1 << 31)
+
 struct checkDEDepthsArgs
 {
   int32_t minDisentangledDepth;
@@ -66,6 +169,14 @@ struct checkDEDepthsArgs
 #endif /* MLTON_GC_INTERNAL_TYPES */
 
 #if (defined(MLTON_GC_INTERNAL_BASIS))
+/* Called by idle processors. If some other processor is currently running a
+ * parallel local collection, join it as a helper. Returns true if any
+ * help was given. */
+PRIVATE Bool GC_HH_tryHelpLocalCollection(GC_state s);
+
+/* True if some processor currently has a parallel local collection job open
+ * for helpers. */
+PRIVATE Bool GC_HH_anyLocalCollectionJobOpen(GC_state s);
 #endif /* MLTON_GC_INTERNAL_BASIS */
 
 #if (defined(MLTON_GC_INTERNAL_FUNCS))
@@ -74,6 +185,8 @@ struct checkDEDepthsArgs
  */
 void HM_HHC_collectLocal(uint32_t desiredScope);
 
+struct LGC_parallelJob* LGC_newParallelJob(void);
+
 /**
  * Forwards the object pointed to by 'opp' into 'destinationLevelList' starting
  * in its last chunk.
@@ -512,6 +512,7 @@ HM_HierarchicalHeap HM_HH_new(GC_state s, uint32_t depth)
   HM_HH_getConcurrentPack(hh)->stack = BOGUS_OBJPTR;
   HM_HH_getConcurrentPack(hh)->additionalStack = BOGUS_OBJPTR;
   HM_HH_getConcurrentPack(hh)->ccstate = CC_UNREG;
+  HM_HH_getConcurrentPack(hh)->weaksCleared = FALSE;
   HM_HH_getConcurrentPack(hh)->bytesSurvivedLastCollection = 0;
   HM_HH_getConcurrentPack(hh)->bytesAllocatedSinceLastCollection = 0;
 
@@ -833,6 +834,51 @@ void mergeCompletedCCs(GC_state s, HM_HierarchicalHeap hh) {
 }
 
 
+/* How far the heap is past s->controls->targetHeap, from 0 (at or below the
+ * target) to 1 (at max-heap, or at twice the target if there is no
+ * max-heap). As it grows, the collection thresholds below shrink toward a
+ * ratio of 1, so that collections become more frequent as the heap
+ * approaches its budget. This runs on every chunk refill, so it uses the
+ * sampled heap usage rather than summing over all processors each time.
+ */
+static double heapBudgetPressure(GC_state s) {
+  size_t target = s->controls->targetHeap;
+  if (0 == target)
+    return 0.0;
+
+  size_t inUse = getRecentHeapBytesInUse(s);
+  if (inUse <= target)
+    return 0.0;
+
+  size_t ceiling =
+    (s->controls->maxHeap > target) ? s->controls->maxHeap : 2 * target;
+  double pressure = (double)(inUse - target) / (double)(ceiling - target);
+  return (pressure > 1.0) ? 1.0 : pressure;
+}
+
+static inline double applyHeapBudget(double ratio, double pressure) {
+  if (ratio <= 1.0)
+    return ratio;
+  return 1.0 + (ratio - 1.0) * (1.0 - pressure);
+}
+
+static inline double collectionThresholdRatio(GC_state s) {
+  double ratio = s->controls->hhConfig.collectionThresholdRatio;
+  if (s->controls->hhConfig.targetGCOverhead > 0.0
+      && s->overheadPolicy.collectionThresholdRatio > 0.0)
+  {
+    ratio = s->overheadPolicy.collectionThresholdRatio;
+  }
+  return applyHeapBudget(ratio, heapBudgetPressure(s));
+}
+
+static inline double ccThresholdRatio(GC_state s) {
+  return applyHeapBudget(
+    s->controls->hhConfig.ccThresholdRatio,
+    heapBudgetPressure(s));
+}
+
+
 bool checkPolicyforRoot(
   GC_state s,
   GC_thread thread)
@@ -871,7 +917,7 @@ bool checkPolicyforRoot(
       HM_HH_getConcurrentPack(cursor)->bytesSurvivedLastCollection;
   }
 
-  if((s->controls->hhConfig.ccThresholdRatio * bytesSurvived) >
+  if((ccThresholdRatio(s) * bytesSurvived) >
       (HM_HH_getConcurrentPack(hh)->bytesAllocatedSinceLastCollection)
     || bytesSurvived == 0) {
     // if (!HM_HH_getConcurrentPack(hh)->shouldCollect) {
@@ -938,6 +984,10 @@ objptr copyStackOfThread(GC_state s, GC_thread thread) {
   GC_stack stack = (GC_stack)(frontier + GC_HEADER_SIZE);
   stack->reserved = reserved;
   stack->used = 0;
+  stack->lastUsed = 0;
+  stack->suspendedCollections = 0;
+  /* the copy is only scanned, never run */
+  initStackSporkFrames(stack);
   HM_updateChunkFrontierInList(
     HM_HH_getChunkList(hh),
     newChunk,
@@ -1109,6 +1159,7 @@ Bool HM_HH_registerCont(pointer kl, pointer kr, pointer k, pointer threadp) {
 #endif
 
   CC_clearStack(s, HM_HH_getConcurrentPack(hh));
+  HM_HH_getConcurrentPack(hh)->weaksCleared = FALSE;
   assert(HM_HH_getConcurrentPack(hh)->ccstate == CC_UNREG);
   __atomic_store_n(&(HM_HH_getConcurrentPack(hh)->ccstate), CC_REG, __ATOMIC_SEQ_CST);
   // HM_HH_getConcurrentPack(hh)->ccstate = CC_REG;
@@ -1158,15 +1209,123 @@ void HM_HH_updateValues(GC_thread thread, pointer frontier) {
     frontier);
 }
 
+/* The compiler emits a fast path in front of GC_writeBarrier which skips the
+ * call when the written object, the old field value and the new value all
+ * live in chunks whose levelHead is exactly this node. In that case the
+ * barrier has nothing to do: the current thread's own heap is never
+ * registered for a CC (registerCont splits it off first), so there is no
+ * snapshot to preserve, and a pointer within one heap is never a
+ * down-pointer. Any other chunk, including one whose levelHead is a stale
+ * node of the same heap, just takes the slow path.
+ *
+ * This has to be refreshed whenever the current thread or its heap changes,
+ * which always happens inside the runtime: see leave() and
+ * setGCStateCurrentThreadAndStack().
+ */
+void HM_HH_updateWriteBarrierLevelHead(GC_state s) {
+  struct HM_UnionFindNode *node = NULL;
+  if (BOGUS_OBJPTR != s->currentThread) {
+    GC_thread thread = getThreadCurrent(s);
+    if (NULL != thread->hierarchicalHeap
+        && HM_HH_getConcurrentPack(thread->hierarchicalHeap)->ccstate == CC_UNREG)
+      node = HM_HH_getUFNode(thread->hierarchicalHeap);
+  }
+  s->writeBarrierLevelHead = node;
+}
+
 size_t HM_HH_nextCollectionThreshold(GC_state s, size_t survivingSize) {
   size_t threshold =
-    (size_t)((double)survivingSize * s->controls->hhConfig.collectionThresholdRatio);
+    (size_t)((double)survivingSize * collectionThresholdRatio(s));
   if (threshold < s->controls->hhConfig.minCollectionSize) {
     threshold = s->controls->hhConfig.minCollectionSize;
   }
   return threshold;
 }
 
+/* Bounds and pacing for the gc-overhead policy. The window must be long
+ * enough to span several collections, or the measured fraction is noise. */
+#define OVERHEAD_WINDOW_NANOSECONDS (20L * 1000L * 1000L)
+#define MIN_OVERHEAD_RATIO 1.25
+#define MAX_OVERHEAD_RATIO 1024.0
+
+static inline double timespecSeconds(struct timespec *t) {
+  return (double)t->tv_sec + 1e-9 * (double)t->tv_nsec;
+}
+
+/* With the gc-overhead policy, nudge this processor's collection threshold
+ * ratio toward the target fraction of time spent in local collections and
+ * CCs. Called at the end of each local collection; adjusts at most once per
+ * window.
+ *
+ * The amount collected is about the same no matter how much was allocated
+ * in between, so the time in GC per allocated byte goes roughly as
+ * 1/(ratio-1). We therefore scale (ratio-1) by the ratio of measured to
+ * target overhead, damped by a square root to avoid oscillating.
+ */
+void HM_HH_adjustCollectionThreshold(GC_state s) {
+  double target = s->controls->hhConfig.targetGCOverhead;
+  if (target <= 0.0)
+    return;
+
+  struct GC_overheadPolicy *policy = &(s->overheadPolicy);
+  struct GC_cumulativeStatistics *stats = s->cumulativeStatistics;
+
+  struct timespec now;
+  timespec_now(&now);
+  struct timespec gcTime = stats->timeLocalGC;
+  timespec_add(&gcTime, &(stats->timeCC));
+
+  if (0.0 == policy->collectionThresholdRatio) {
+    /* first call: start from the configured ratio */
+    policy->collectionThresholdRatio =
+      s->controls->hhConfig.collectionThresholdRatio;
+    policy->windowStart = now;
+    policy->windowGCTime = gcTime;
+    stats->collectionThresholdRatio = policy->collectionThresholdRatio;
+    stats->minCollectionThresholdRatio = policy->collectionThresholdRatio;
+    stats->maxCollectionThresholdRatio = policy->collectionThresholdRatio;
+    return;
+  }
+
+  struct timespec elapsed = now;
+  timespec_sub(&elapsed, &(policy->windowStart));
+  if ((double)elapsed.tv_sec * 1e9 + (double)elapsed.tv_nsec
+      < (double)OVERHEAD_WINDOW_NANOSECONDS)
+  {
+    return;
+  }
+
+  struct timespec gcElapsed = gcTime;
+  timespec_sub(&gcElapsed, &(policy->windowGCTime));
+  double overhead = timespecSeconds(&gcElapsed) / timespecSeconds(&elapsed);
+
+  double factor = sqrt(overhead / target);
+  if (factor < 0.5) factor = 0.5;
+  if (factor > 2.0) factor = 2.0;
+
+  double ratio = 1.0 + (policy->collectionThresholdRatio - 1.0) * factor;
+  if (ratio < MIN_OVERHEAD_RATIO) ratio = MIN_OVERHEAD_RATIO;
+  if (ratio > MAX_OVERHEAD_RATIO) ratio = MAX_OVERHEAD_RATIO;
+
+  LOG(LM_HIERARCHICAL_HEAP, LL_DEBUG,
+    "gc overhead %.3f (target %.3f): collection threshold ratio %.2f -> %.2f",
+    overhead,
+    target,
+    policy->collectionThresholdRatio,
+    ratio);
+
+  policy->collectionThresholdRatio = ratio;
+  policy->windowStart = now;
+  policy->windowGCTime = gcTime;
+
+  stats->collectionThresholdRatio = ratio;
+  stats->minCollectionThresholdRatio =
+    min(stats->minCollectionThresholdRatio, ratio);
+  stats->maxCollectionThresholdRatio =
+    max(stats->maxCollectionThresholdRatio, ratio);
+  stats->numCollectionThresholdAdjustments++;
+}
+
 size_t HM_HH_addRecentBytesAllocated(GC_thread thread, size_t bytes) {
   thread->bytesAllocatedSinceLastCollection += bytes;
   return thread->bytesAllocatedSinceLastCollection;
@@ -1180,7 +1339,7 @@ uint32_t HM_HH_desiredCollectionScope(GC_state s, GC_thread thread)
     return thread->currentDepth+1; /* don't collect */
 
   if (thread->bytesAllocatedSinceLastCollection <
-      (s->controls->hhConfig.collectionThresholdRatio * thread->bytesSurvivedLastCollection))
+      (collectionThresholdRatio(s) * thread->bytesSurvivedLastCollection))
   {
     return thread->currentDepth+1; /* don't collect */
   }
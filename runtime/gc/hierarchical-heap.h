@@ -145,8 +145,10 @@ HM_HierarchicalHeap HM_HH_getCurrent(GC_state s);
 pointer HM_HH_getFrontier(GC_thread thread);
 pointer HM_HH_getLimit(GC_thread thread);
 void HM_HH_updateValues(GC_thread thread, pointer frontier);
+void HM_HH_updateWriteBarrierLevelHead(GC_state s);
 
 size_t HM_HH_nextCollectionThreshold(GC_state s, size_t survivingSize);
+void HM_HH_adjustCollectionThreshold(GC_state s);
 size_t HM_HH_addRecentBytesAllocated(GC_thread thread, size_t bytes);
 
 uint32_t HM_HH_desiredCollectionScope(GC_state s, GC_thread thread);
@@ -205,6 +205,42 @@ int processAtMLton (GC_state s, int start, int argc, char **argv,
           if (i == argc || (0 == strcmp (argv[i], "--")))
             die ("%s affinity-stride missing argument.", atName);
           s->controls->affinityStride = stringToInt (argv[i++]);
+        } else if (0 == strcmp (arg, "hash-cons")) {
+          i++;
+          s->controls->hashConsDuringGC = TRUE;
+        } else if (0 == strcmp (arg, "shrink-stacks")) {
+          i++;
+          if (i == argc || (0 == strcmp (argv[i], "--")))
+            die ("%s shrink-stacks missing argument.", atName);
+          s->controls->shrinkStacks = stringToBool (argv[i++]);
+        } else if (0 == strcmp (arg, "stack-hibernate-collections")) {
+          i++;
+          if (i == argc || (0 == strcmp (argv[i], "--")))
+            die ("%s stack-hibernate-collections missing argument.", atName);
+          int n = stringToInt (argv[i++]);
+          unless (n >= 0)
+            die ("%s stack-hibernate-collections must be non-negative.", atName);
+          s->controls->stackHibernateCollections = (uint32_t)n;
+        } else if (0 == strcmp (arg, "elastic-workers")) {
+          i++;
+          s->controls->elasticWorkers = TRUE;
+        } else if (0 == strcmp (arg, "elastic-period")) {
+          i++;
+          if (i == argc || (0 == strcmp (argv[i], "--")))
+            die ("%s elastic-period missing argument.", atName);
+          struct timespec tm;
+          stringToTime(argv[i++], &tm);
+          s->controls->elasticPeriod = tm;
+        } else if (0 == strcmp (arg, "affinity-topology")) {
+          i++;
+          s->controls->affinityTopology = TRUE;
+          s->controls->setAffinity = TRUE;
+        } else if (0 == strcmp (arg, "numa-aware")) {
+          /* Blocks are placed on the node of the allocating processor,
+           * which is only meaningful if processors stay put. */
+          i++;
+          s->controls->numaAware = TRUE;
+          s->controls->setAffinity = TRUE;
         } else if (0 == strcmp (arg, "debug-keep-free-blocks")) {
           i++;
           s->controls->debugKeepFreeBlocks = TRUE;
@@ -229,6 +265,29 @@ int processAtMLton (GC_state s, int start, int argc, char **argv,
           if (i == argc || (0 == strcmp (argv[i], "--")))
             die ("%s heartbeat-relayer-threshold missing argument.", atName);
           s->controls->heartbeatRelayerThreshold = stringToInt (argv[i++]);
+        } else if (0 == strcmp (arg, "heartbeat-mode")) {
+          i++;
+          if (i == argc || (0 == strcmp (argv[i], "--")))
+            die ("%s heartbeat-mode missing argument.", atName);
+          const char* mode = argv[i++];
+          if (0 == strcmp (mode, "signal")) {
+            s->controls->heartbeatMode = HEARTBEAT_SIGNAL;
+          } else if (0 == strcmp (mode, "poll")) {
+            s->controls->heartbeatMode = HEARTBEAT_POLL;
+          } else {
+            die ("%s heartbeat-mode \"%s\" invalid. Must be one of "
+                 "signal or poll.",
+                 atName,
+                 mode);
+          }
+        } else if (0 == strcmp (arg, "heartbeat-relay-fanout")) {
+          i++;
+          if (i == argc || (0 == strcmp (argv[i], "--")))
+            die ("%s heartbeat-relay-fanout missing argument.", atName);
+          int fanout = stringToInt (argv[i++]);
+          if (fanout < 1)
+            die ("%s heartbeat-relay-fanout must be at least 1.", atName);
+          s->controls->heartbeatRelayFanout = (uint32_t)fanout;
         } else if (0 == strcmp (arg, "load-world")) {
           unless (s->controls->mayLoadWorld)
             die ("May not load world.");
@@ -360,6 +419,12 @@ int processAtMLton (GC_state s, int start, int argc, char **argv,
             die ("%s alloc-blocks-min-size missing argument.", atName);
           }
           s->controls->allocBlocksMinSize = stringToBytes(argv[i++]);
+        } else if (0 == strcmp(arg, "stack-pool-size")) {
+          i++;
+          if (i == argc || (0 == strcmp (argv[i], "--"))) {
+            die ("%s stack-pool-size missing argument.", atName);
+          }
+          s->controls->stackPoolSize = stringToBytes(argv[i++]);
         } else if (0 == strcmp(arg, "emptiness-fraction")) {
           i++;
           if (i == argc || (0 == strcmp (argv[i], "--"))) {
@@ -399,6 +464,56 @@ int processAtMLton (GC_state s, int start, int argc, char **argv,
           struct timespec tm;
           stringToTime(argv[i++], &tm);
           s->controls->blockUsageSampleInterval = tm;
+        } else if (0 == strcmp(arg, "decommit-delay")) {
+          i++;
+          if (i == argc || (0 == strcmp (argv[i], "--"))) {
+            die ("%s decommit-delay missing argument.", atName);
+          }
+          struct timespec tm;
+          stringToTime(argv[i++], &tm);
+          s->controls->decommitDelay = tm;
+        } else if (0 == strcmp(arg, "huge-pages")) {
+          i++;
+          if (i == argc || (0 == strcmp (argv[i], "--"))) {
+            die ("%s huge-pages missing argument.", atName);
+          }
+          const char* mode = argv[i++];
+          if (0 == strcmp (mode, "none")) {
+            s->controls->hugePages = HUGE_PAGES_NONE;
+          } else if (0 == strcmp (mode, "thp")) {
+            s->controls->hugePages = HUGE_PAGES_THP;
+          } else if (0 == strcmp (mode, "hugetlb")) {
+            s->controls->hugePages = HUGE_PAGES_HUGETLB;
+          } else {
+            die ("%s huge-pages \"%s\" invalid. Must be one of "
+                 "none, thp, or hugetlb.",
+                 atName,
+                 mode);
+          }
+        } else if (0 == strcmp(arg, "target-rss")) {
+          i++;
+          if (i == argc || (0 == strcmp (argv[i], "--"))) {
+            die ("%s target-rss missing argument.", atName);
+          }
+          s->controls->targetRSS = stringToBytes(argv[i++]);
+        } else if (0 == strcmp(arg, "megablock-cache")) {
+          i++;
+          if (i == argc || (0 == strcmp (argv[i], "--"))) {
+            die ("%s megablock-cache missing argument.", atName);
+          }
+          s->controls->megablockCacheSize = stringToBytes(argv[i++]);
+        } else if (0 == strcmp(arg, "max-heap")) {
+          i++;
+          if (i == argc || (0 == strcmp (argv[i], "--"))) {
+            die ("%s max-heap missing argument.", atName);
+          }
+          s->controls->maxHeap = stringToBytes(argv[i++]);
+        } else if (0 == strcmp(arg, "target-heap")) {
+          i++;
+          if (i == argc || (0 == strcmp (argv[i], "--"))) {
+            die ("%s target-heap missing argument.", atName);
+          }
+          s->controls->targetHeap = stringToBytes(argv[i++]);
         } else if (0 == strcmp (arg, "collection-type")) {
           i++;
           if (i == argc || (0 == strcmp (argv[i], "--"))) {
@@ -427,6 +542,17 @@ int processAtMLton (GC_state s, int start, int argc, char **argv,
           if (s->controls->hhConfig.collectionThresholdRatio < 1.0) {
             die("%s collection-threshold-ratio must be at least 1.0", atName);
           }
+        } else if (0 == strcmp(arg, "target-gc-overhead")) {
+          i++;
+          if (i == argc || (0 == strcmp (argv[i], "--"))) {
+            die ("%s target-gc-overhead missing argument.", atName);
+          }
+
+          s->controls->hhConfig.targetGCOverhead = stringToFloat(argv[i++]);
+          if (s->controls->hhConfig.targetGCOverhead <= 0.0
+              || s->controls->hhConfig.targetGCOverhead >= 1.0) {
+            die("%s target-gc-overhead must be between 0.0 and 1.0", atName);
+          }
         } else if (0 == strcmp (arg, "cc-threshold-ratio")) {
           i++;
           if (i == argc || (0 == strcmp (argv[i], "--"))) {
@@ -484,6 +610,48 @@ int processAtMLton (GC_state s, int start, int argc, char **argv,
             die ("%s max-cc-depth must be >= 0", atName);
           }
           s->controls->hhConfig.maxCCDepth = maxd;
+        } else if (0 == strcmp(arg, "parallel-lgc")) {
+          i++;
+          s->controls->hhConfig.parallelLocalCollection = TRUE;
+        } else if (0 == strcmp(arg, "parallel-lgc-min-size")) {
+          i++;
+          if (i == argc || (0 == strcmp (argv[i], "--"))) {
+            die ("%s parallel-lgc-min-size missing argument.", atName);
+          }
+
+          s->controls->hhConfig.minParallelLocalCollectionSize = stringToBytes(argv[i++]);
+        } else if (0 == strcmp(arg, "parallel-lgc-max-helpers")) {
+          i++;
+          if (i == argc || (0 == strcmp (argv[i], "--"))) {
+            die ("%s parallel-lgc-max-helpers missing argument.", atName);
+          }
+
+          int helpers = stringToInt(argv[i++]);
+          if (helpers < 0) {
+            die ("%s parallel-lgc-max-helpers must be >= 0", atName);
+          }
+          s->controls->hhConfig.maxLocalCollectionHelpers = helpers;
+        } else if (0 == strcmp(arg, "parallel-cc")) {
+          i++;
+          s->controls->hhConfig.parallelCC = TRUE;
+        } else if (0 == strcmp(arg, "parallel-cc-min-size")) {
+          i++;
+          if (i == argc || (0 == strcmp (argv[i], "--"))) {
+            die ("%s parallel-cc-min-size missing argument.", atName);
+          }
+
+          s->controls->hhConfig.minParallelCCSize = stringToBytes(argv[i++]);
+        } else if (0 == strcmp(arg, "parallel-cc-max-helpers")) {
+          i++;
+          if (i == argc || (0 == strcmp (argv[i], "--"))) {
+            die ("%s parallel-cc-max-helpers missing argument.", atName);
+          }
+
+          int helpers = stringToInt(argv[i++]);
+          if (helpers < 0) {
+            die ("%s parallel-cc-max-helpers must be >= 0", atName);
+          }
+          s->controls->hhConfig.maxCCHelpers = helpers;
         } else if (0 == strcmp(arg, "trace-buffer-size")) {
           i++;
           if (i == argc || (0 == strcmp (argv[i], "--"))) {
@@ -528,6 +696,14 @@ int GC_init (GC_state s, int argc, char **argv) {
   s->controls->setAffinity = FALSE;
   s->controls->affinityBase = 0;
   s->controls->affinityStride = 1;
+  s->controls->affinityTopology = FALSE;
+  s->controls->hashConsDuringGC = FALSE;
+  s->controls->shrinkStacks = TRUE;
+  s->controls->stackHibernateCollections = 4;
+  s->controls->elasticWorkers = FALSE;
+  s->controls->elasticPeriod.tv_sec = 0;
+  s->controls->elasticPeriod.tv_nsec = 100000000;
+  s->controls->numaAware = FALSE;
   s->controls->ratios.ramSlop = 0.5f;
   s->controls->ratios.stackCurrentGrow = 2.0f;
   s->controls->ratios.stackCurrentMaxReserved = 32.0f;
@@ -536,12 +712,19 @@ int GC_init (GC_state s, int argc, char **argv) {
   s->controls->ratios.stackMaxReserved = 8.0f;
   s->controls->ratios.stackShrink = 0.5f;
   s->controls->hhConfig.collectionThresholdRatio = 8.0;
+  s->controls->hhConfig.targetGCOverhead = 0.0;
   s->controls->hhConfig.minCollectionSize = 1024L * 1024L;
   s->controls->hhConfig.minCCSize = 1024L * 1024L;
   s->controls->hhConfig.maxCCChainLength = 2;
   s->controls->hhConfig.ccThresholdRatio = 2.0f;
   s->controls->hhConfig.maxCCDepth = 3;
   s->controls->hhConfig.minLocalDepth = 2;
+  s->controls->hhConfig.parallelLocalCollection = FALSE;
+  s->controls->hhConfig.minParallelLocalCollectionSize = 16L * 1024L * 1024L;
+  s->controls->hhConfig.maxLocalCollectionHelpers = 63;
+  s->controls->hhConfig.parallelCC = FALSE;
+  s->controls->hhConfig.minParallelCCSize = 16L * 1024L * 1024L;
+  s->controls->hhConfig.maxCCHelpers = 63;
   s->controls->rusageMeasureGC = FALSE;
   s->controls->summary = FALSE;
   s->controls->summaryFormat = HUMAN;
@@ -557,15 +740,28 @@ int GC_init (GC_state s, int argc, char **argv) {
   s->controls->blockUsageSampleInterval.tv_sec = 1;
   s->controls->blockUsageSampleInterval.tv_nsec = 0;
 
+  // default: decommit free blocks after they have been unused for a second
+  s->controls->decommitDelay.tv_sec = 1;
+  s->controls->decommitDelay.tv_nsec = 0;
+  s->controls->targetRSS = 0;
+  s->controls->megablockCacheSize = 32 * 1024 * 1024;
+  s->controls->maxHeap = 0;
+  s->controls->targetHeap = 0;
+  s->controls->hugePages = HUGE_PAGES_NONE;
+  s->controls->hugePageSize = 0;
+
   s->controls->heartbeatStats = FALSE;
   s->controls->heartbeatMicroseconds = 500;
   s->controls->heartbeatTokens = 30;
   s->controls->heartbeatRelayerThreshold = 16;
+  s->controls->heartbeatRelayFanout = 8;
+  s->controls->heartbeatMode = HEARTBEAT_SIGNAL;
 
   /* Not arbitrary; should be at least the page size and must also respect the
    * limit check coalescing amount in the compiler. */
   s->controls->blockSize = max(GC_pageSize(), 4096);
   s->controls->allocBlocksMinSize = 1024 * s->controls->blockSize;
+  s->controls->stackPoolSize = 1024 * 1024;
 
   /* check if still equal to 0 after process @mpl to see if the user wants
    * a particular size, and if not, set to default. */
@@ -583,8 +779,13 @@ int GC_init (GC_state s, int argc, char **argv) {
   s->wsQueue = BOGUS_OBJPTR;
   s->wsQueueTop = BOGUS_OBJPTR;
   s->wsQueueBot = BOGUS_OBJPTR;
+  s->writeBarrierLevelHead = NULL;
+  HM_initChunkList(&(s->stackChunkPool));
 
   s->lastMajorStatistics = newLastMajorStatistics();
+  s->lgcJob = LGC_newParallelJob();
+  s->ccJob = CC_newParallelJob();
+  initOverheadPolicy(&(s->overheadPolicy));
 
   s->numberOfProcs = 1;
   s->procStates = NULL;
@@ -607,6 +808,8 @@ int GC_init (GC_state s, int argc, char **argv) {
   s->self = pthread_self();
   s->terminationLeader = INVALID_PROCESSOR_NUMBER;
   s->terminationStatus = 1;
+  s->heartbeatRelayPending = 0;
+  s->heartbeatPollPending = 0;
   s->sysvals.pageSize = GC_pageSize ();
   s->sysvals.physMem = GC_physMem ();
   s->weaks = NULL;
@@ -663,6 +866,21 @@ int GC_init (GC_state s, int argc, char **argv) {
   unless (isAligned(s->controls->blockSize, s->sysvals.pageSize))
     die ("block-size must be a multiple of the system page size (%zu)", s->sysvals.pageSize);
 
+  if (s->controls->maxHeap != 0) {
+    /* by default, start collecting more eagerly at 3/4 of the max-heap */
+    if (s->controls->targetHeap == 0)
+      s->controls->targetHeap = s->controls->maxHeap / 4 * 3;
+    unless (s->controls->targetHeap <= s->controls->maxHeap)
+      die ("target-heap (currently %zu) must be at most the max-heap (currently %zu)",
+        s->controls->targetHeap,
+        s->controls->maxHeap);
+  }
+
+  if (s->controls->elasticWorkers
+      && 0 == s->controls->elasticPeriod.tv_sec
+      && 0 == s->controls->elasticPeriod.tv_nsec)
+    die ("elastic-period must be positive");
+
   if (s->controls->allocChunkSize == 0) {
     /* user didn't specify a specify alloc-chunk size, so set a default. */
     size_t bs = s->controls->blockSize;
@@ -681,6 +899,16 @@ int GC_init (GC_state s, int argc, char **argv) {
       s->controls->superblockThreshold,
       s->controls->megablockThreshold);
 
+  if (HUGE_PAGES_NONE != s->controls->hugePages) {
+    s->controls->hugePageSize = GC_hugePageSize();
+    if (0 == s->controls->hugePageSize)
+      die ("huge-pages are not supported on this system.");
+    unless (isAligned(s->controls->hugePageSize, s->controls->blockSize))
+      die ("the huge page size (%zu) must be a multiple of the block-size (%zu)",
+        s->controls->hugePageSize,
+        s->controls->blockSize);
+  }
+
   unless (s->controls->heartbeatRelayerThreshold >= 1)
     die ("heartbeat-relayer-threshold must be at least 1.");
 
@@ -697,10 +925,12 @@ void GC_lateInit(GC_state s) {
 
   initLocalBlockAllocator(s, initGlobalBlockAllocator(s));
   s->blockUsageSampler = newBlockUsageSampler(s);
+  s->heapUsageSampler = newHeapUsageSampler(s);
 
   s->nextChunkAllocSize = s->controls->allocChunkSize;
 
   set_max_gdtoa_threads(s->numberOfProcs);
+  Proc_initTopology(s);
 
   /* Initialize profiling.  This must occur after processing
    * command-line arguments, because those may just be doing a
@@ -731,8 +961,12 @@ void GC_duplicate (GC_state d, GC_state s) {
   d->wsQueue = BOGUS_OBJPTR;
   d->wsQueueTop = BOGUS_OBJPTR;
   d->wsQueueBot = BOGUS_OBJPTR;
+  d->blockMask = ~((uintptr_t)s->controls->blockSize - 1);
+  d->writeBarrierLevelHead = NULL;
+  HM_initChunkList(&(d->stackChunkPool));
   initLocalBlockAllocator(d, s->blockAllocatorGlobal);
   d->blockUsageSampler = s->blockUsageSampler;
+  d->heapUsageSampler = s->heapUsageSampler;
   initFixedSizeAllocator(getHHAllocator(d), sizeof(struct HM_HierarchicalHeap), BLOCK_FOR_HH_ALLOCATOR);
   initFixedSizeAllocator(getUFAllocator(d), sizeof(struct HM_UnionFindNode), BLOCK_FOR_UF_ALLOCATOR);
   d->hhEBR = s->hhEBR;
@@ -740,7 +974,12 @@ void GC_duplicate (GC_state d, GC_state s) {
   d->nextChunkAllocSize = s->nextChunkAllocSize;
   d->lastHeartbeatBroadcast = s->lastHeartbeatBroadcast;
   d->lastMajorStatistics = newLastMajorStatistics();
+  d->lgcJob = LGC_newParallelJob();
+  d->ccJob = CC_newParallelJob();
+  initOverheadPolicy(&(d->overheadPolicy));
   d->numberOfProcs = s->numberOfProcs;
+  d->procCPUs = s->procCPUs;
+  d->procDistances = s->procDistances;
   d->numberDisentanglementChecks = 0;
   d->roots = NULL;
   d->rootsLength = 0;
@@ -756,6 +995,8 @@ void GC_duplicate (GC_state d, GC_state s) {
   d->self = s->self;
   d->terminationLeader = INVALID_PROCESSOR_NUMBER;
   d->terminationStatus = 1;
+  d->heartbeatRelayPending = 0;
+  d->heartbeatPollPending = 0;
   d->sysvals.pageSize = s->sysvals.pageSize;
   d->sysvals.physMem = s->sysvals.physMem;
   d->weaks = s->weaks;
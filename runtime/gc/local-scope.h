@@ -9,11 +9,16 @@
 
 #if (defined (MLTON_GC_INTERNAL_TYPES))
 
-#define DEQUE_CAPACITY_BITS   6
-#define MAX_IDX               ((((uint64_t)1) << DEQUE_CAPACITY_BITS) - 1)
-#define UNPACK_TAG(topval)    ((topval) >> DEQUE_CAPACITY_BITS)
+/* The scheduler deque (basis-library/schedulers/shh/queue/DequeABP.sml) packs
+ * its top index into the low DEQUE_IDX_BITS bits of wsQueueTop, with a tag in
+ * the remaining high bits. The deque is growable, so the index is not bounded
+ * by the length of the registered wsQueue array at the time of registration;
+ * the scheduler re-registers wsQueue whenever it grows the array. */
+#define DEQUE_IDX_BITS        32
+#define MAX_IDX               ((((uint64_t)1) << DEQUE_IDX_BITS) - 1)
+#define UNPACK_TAG(topval)    ((topval) >> DEQUE_IDX_BITS)
 #define UNPACK_IDX(topval)    ((topval) & MAX_IDX)
-#define PACK_TAGIDX(tag, idx) (((tag) << DEQUE_CAPACITY_BITS) | (idx))
+#define PACK_TAGIDX(tag, idx) (((tag) << DEQUE_IDX_BITS) | (idx))
 
 #endif /* defined (MLTON_GC_INTERNAL_TYPES) */
 
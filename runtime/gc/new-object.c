@@ -71,6 +71,9 @@ GC_stack newStack(GC_state s, size_t reserved) {
 
   stack->reserved = reserved;
   stack->used = 0;
+  stack->lastUsed = 0;
+  stack->suspendedCollections = 0;
+  initStackSporkFrames(stack);
   if (DEBUG_STACKS)
     fprintf (stderr, FMTPTR " = newStack (%"PRIuMAX")\n",
              (uintptr_t)stack,
@@ -129,6 +132,61 @@ GC_thread newThread(GC_state s, size_t reserved) {
   return thread;
 }
 
+/* Stacks of threads that have finished and been joined are kept in a small
+ * per-processor pool (s->stackChunkPool), so that the next thread created by
+ * newThreadWithHeap (for example, by a thief starting on a stolen task) can
+ * take its stack chunk from there instead of from the block allocator.
+ *
+ * Only a stack that sits alone in its own chunk, in the thread's own leaf
+ * heap, is taken, and only if no CC is registered on that heap: then nothing
+ * else can reach the chunk once the thread's stack field is cleared. The
+ * thread object itself may still be reachable (e.g., through the scheduler's
+ * join slot) and shares its chunk with other objects, so it is not pooled.
+ */
+void poolThreadStack(GC_state s, GC_thread thread) {
+  if (0 == s->controls->stackPoolSize
+      || BOGUS_OBJPTR == thread->stack
+      || NULL == thread->hierarchicalHeap)
+    return;
+
+  HM_HierarchicalHeap hh = thread->hierarchicalHeap;
+  if (HM_HH_getConcurrentPack(hh)->ccstate != CC_UNREG
+      || NULL != hh->subHeapForCC
+      || NULL != hh->subHeapCompletedCC)
+    return;
+
+  pointer stackp = objptrToPointer(thread->stack, NULL);
+  HM_chunk chunk = HM_getChunkOf(stackp);
+  if (chunk->mightContainMultipleObjects
+      || chunk->retireChunk
+      || stackp - GC_HEADER_SIZE != HM_getChunkStart(chunk)
+      || HM_getLevelHead(chunk) != hh
+      || s->stackChunkPool.size + HM_getChunkSize(chunk) > s->controls->stackPoolSize)
+    return;
+
+  HM_unlinkChunk(HM_HH_getChunkList(hh), chunk);
+  thread->stack = BOGUS_OBJPTR;
+  chunk->frontier = HM_getChunkStart(chunk);
+  HM_appendChunk(&(s->stackChunkPool), chunk);
+  s->cumulativeStatistics->numStacksPooled++;
+}
+
+/* Take a pooled stack chunk with room for bytesRequested, or NULL. */
+HM_chunk takePooledStackChunk(GC_state s, size_t bytesRequested) {
+  for (HM_chunk chunk = HM_getChunkListFirstChunk(&(s->stackChunkPool));
+       NULL != chunk;
+       chunk = chunk->nextChunk)
+  {
+    if (HM_getChunkSizePastFrontier(chunk) > bytesRequested) {
+      HM_unlinkChunk(&(s->stackChunkPool), chunk);
+      s->cumulativeStatistics->numStackPoolHits++;
+      return chunk;
+    }
+  }
+  s->cumulativeStatistics->numStackPoolMisses++;
+  return NULL;
+}
+
 GC_thread newThreadWithHeap(
   GC_state s,
   size_t reserved,
@@ -151,10 +209,14 @@ GC_thread newThreadWithHeap(
     threadSize,
     BLOCK_FOR_HEAP_CHUNK);
     
-  HM_chunk sChunk = HM_allocateChunkWithPurpose(
-    HM_HH_getChunkList(hh),
-    stackSize,
-    BLOCK_FOR_HEAP_CHUNK);
+  HM_chunk sChunk = takePooledStackChunk(s, stackSize);
+  if (NULL != sChunk)
+    HM_appendChunk(HM_HH_getChunkList(hh), sChunk);
+  else
+    sChunk = HM_allocateChunkWithPurpose(
+      HM_HH_getChunkList(hh),
+      stackSize,
+      BLOCK_FOR_HEAP_CHUNK);
     
   if (NULL == sChunk || NULL == tChunk) {
     DIE("Ran out of space for thread+stack allocation!");
@@ -183,6 +245,9 @@ GC_thread newThreadWithHeap(
 
   stack->reserved = reserved;
   stack->used = 0;
+  stack->lastUsed = 0;
+  stack->suspendedCollections = 0;
+  initStackSporkFrames(stack);
 
   thread->spareHeartbeatTokens = 0;
   thread->currentProcNum = -1;
@@ -12,6 +12,8 @@ static inline pointer newObject(GC_state s, GC_header header, size_t bytesReques
 static inline GC_stack newStack(GC_state s, size_t reserved);
 static GC_thread newThread(GC_state s, size_t stackSize);
 static GC_thread newThreadWithHeap(GC_state s, size_t stackSize, uint32_t depth);
+static void poolThreadStack(GC_state s, GC_thread thread);
+static HM_chunk takePooledStackChunk(GC_state s, size_t bytesRequested);
 static inline void setFrontier(GC_state s, pointer p, size_t bytes);
 
 #endif /* (defined (MLTON_GC_INTERNAL_FUNCS)) */
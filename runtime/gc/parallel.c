@@ -1,6 +1,10 @@
 #include <pthread.h>
 #include <time.h>
 #include "platform.h"
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
 
 void Parallel_init (void) {
   GC_state s = pthread_getspecific (gcstate_key);
@@ -190,3 +194,222 @@ Int32 Parallel_arrayFetchAndAdd32 (Pointer p, GC_sequenceLength i, Int32 v) {
 Int64 Parallel_arrayFetchAndAdd64 (Pointer p, GC_sequenceLength i, Int64 v) {
   return __sync_fetch_and_add (((Int64*)p)+i, v);
 }
+
+/* Parking for idle processors.
+ *
+ * An idle processor calls Parallel_idlePrepare (which registers it as a
+ * sleeper and returns the current idle epoch), checks one last time for
+ * work, and then either calls Parallel_idleCancel or Parallel_idlePark.
+ * Whenever new work is made available, Parallel_idleWakeOne bumps the
+ * epoch and wakes one sleeper, but only if there are any, so that this is
+ * just a load in the common case.
+ *
+ * Both sides do a sequentially consistent RMW before checking the other
+ * side (the sleeper increments the number of sleepers before its last check
+ * for work; the scheduler publishes work with a compare-and-swap before
+ * reading the number of sleepers), so a wakeup cannot be lost. Parks are
+ * additionally bounded by a timeout.
+ */
+static volatile uint32_t Parallel_idleEpoch = 0;
+static volatile uint32_t Parallel_numIdleSleepers = 0;
+#if !defined(__linux__)
+static pthread_mutex_t Parallel_idleLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t Parallel_idleCond = PTHREAD_COND_INITIALIZER;
+#endif
+
+Word32 Parallel_idlePrepare (void) {
+  __atomic_add_fetch(&Parallel_numIdleSleepers, 1, __ATOMIC_SEQ_CST);
+  return __atomic_load_n(&Parallel_idleEpoch, __ATOMIC_SEQ_CST);
+}
+
+void Parallel_idleCancel (void) {
+  __atomic_sub_fetch(&Parallel_numIdleSleepers, 1, __ATOMIC_SEQ_CST);
+}
+
+void Parallel_idlePark (Word32 epoch, Word64 timeoutNanoseconds) {
+  GC_state s = pthread_getspecific (gcstate_key);
+
+  struct timespec timeout;
+  timeout.tv_sec = (time_t)(timeoutNanoseconds / 1000000000);
+  timeout.tv_nsec = (long)(timeoutNanoseconds % 1000000000);
+
+  /* Nothing else is allocating on this processor; if it stays idle, this is
+   * what returns its free memory to the OS. Take in the blocks that other
+   * processors freed for us first, so that they can be decommitted too. */
+  reclaimRemoteFrees(s);
+  maybeDecommitIdleBlocks(s);
+
+  /* We hold no references to EBR-protected data while parked; don't hold up
+   * reclamation on other processors. */
+  HH_EBR_enterQuiescentState(s);
+  HM_EBR_enterQuiescentState(s);
+
+  struct timespec start;
+  timespec_now(&start);
+
+#if defined(__linux__)
+  syscall(SYS_futex, &Parallel_idleEpoch, FUTEX_WAIT_PRIVATE, epoch,
+          &timeout, NULL, 0);
+#else
+  struct timespec deadline;
+  clock_gettime(CLOCK_REALTIME, &deadline);
+  timespec_add(&deadline, &timeout);
+  pthread_mutex_lock(&Parallel_idleLock);
+  if (epoch == __atomic_load_n(&Parallel_idleEpoch, __ATOMIC_SEQ_CST))
+    pthread_cond_timedwait(&Parallel_idleCond, &Parallel_idleLock, &deadline);
+  pthread_mutex_unlock(&Parallel_idleLock);
+#endif
+
+  struct timespec stop;
+  timespec_now(&stop);
+  timespec_sub(&stop, &start);
+
+  __atomic_sub_fetch(&Parallel_numIdleSleepers, 1, __ATOMIC_SEQ_CST);
+
+  HH_EBR_leaveQuiescentState(s);
+  HM_EBR_leaveQuiescentState(s);
+
+  s->cumulativeStatistics->numIdleParks++;
+  timespec_add(&(s->cumulativeStatistics->timeIdleParked), &stop);
+
+  GC_MayTerminateThread(s);
+}
+
+void Parallel_idleWakeOne (void) {
+  if (0 == __atomic_load_n(&Parallel_numIdleSleepers, __ATOMIC_SEQ_CST))
+    return;
+
+  __atomic_add_fetch(&Parallel_idleEpoch, 1, __ATOMIC_SEQ_CST);
+
+#if defined(__linux__)
+  syscall(SYS_futex, &Parallel_idleEpoch, FUTEX_WAKE_PRIVATE, 1,
+          NULL, NULL, 0);
+#else
+  pthread_mutex_lock(&Parallel_idleLock);
+  pthread_cond_signal(&Parallel_idleCond);
+  pthread_mutex_unlock(&Parallel_idleLock);
+#endif
+
+  GC_state s = pthread_getspecific (gcstate_key);
+  if (NULL != s)
+    s->cumulativeStatistics->numIdleWakeups++;
+}
+
+/* Elastic workers (elastic-workers): the number of workers that should be
+ * active is recomputed from the CPU quota at most once per elastic-period,
+ * by whichever processor first notices that the period has passed. Workers
+ * numbered at or above it park on their own futex word, separately from
+ * idle workers, so that a wakeup for new work never goes to a worker that
+ * would just park again. When the limit grows, all of them are woken to
+ * check whether they are needed; they also wake up every elastic-period on
+ * their own, which is what keeps the quota up to date while all of the
+ * active workers are busy.
+ */
+static volatile uint32_t Parallel_activeWorkerLimit = 0;
+static volatile uint32_t Parallel_elasticEpoch = 0;
+static volatile uint64_t Parallel_nextQuotaCheck = 0;
+
+static uint64_t timespecToNanoseconds (struct timespec *t) {
+  return (uint64_t)t->tv_sec * 1000000000 + (uint64_t)t->tv_nsec;
+}
+
+static uint32_t workersForQuota (GC_state s) {
+  double quota = GC_cpuQuota();
+  uint32_t limit = s->numberOfProcs;
+  if (quota > 0.0 && quota < (double)limit) {
+    /* Round up, so that a fractional CPU is still used. */
+    limit = (uint32_t)ceil(quota);
+    if (limit < 1)
+      limit = 1;
+  }
+  return limit;
+}
+
+Word32 Parallel_activeWorkers (void) {
+  GC_state s = pthread_getspecific (gcstate_key);
+  if (!s->controls->elasticWorkers)
+    return s->numberOfProcs;
+
+  struct timespec now;
+  timespec_now(&now);
+  uint64_t nowNs = timespecToNanoseconds(&now);
+  uint64_t next = __atomic_load_n(&Parallel_nextQuotaCheck, __ATOMIC_RELAXED);
+  uint32_t limit = __atomic_load_n(&Parallel_activeWorkerLimit, __ATOMIC_SEQ_CST);
+
+  if ((nowNs >= next || 0 == limit)
+      && __atomic_compare_exchange_n(&Parallel_nextQuotaCheck, &next,
+           nowNs + timespecToNanoseconds(&(s->controls->elasticPeriod)),
+           FALSE, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+  {
+    uint32_t newLimit = workersForQuota(s);
+    uint32_t oldLimit =
+      __atomic_exchange_n(&Parallel_activeWorkerLimit, newLimit, __ATOMIC_SEQ_CST);
+    if (newLimit != oldLimit) {
+      LOG(LM_PARALLEL, LL_INFO,
+        "active workers: %"PRIu32" -> %"PRIu32,
+        oldLimit,
+        newLimit);
+      s->cumulativeStatistics->numActiveWorkerChanges++;
+    }
+    if (newLimit > oldLimit) {
+      __atomic_add_fetch(&Parallel_elasticEpoch, 1, __ATOMIC_SEQ_CST);
+#if defined(__linux__)
+      syscall(SYS_futex, &Parallel_elasticEpoch, FUTEX_WAKE_PRIVATE, INT_MAX,
+              NULL, NULL, 0);
+#else
+      pthread_mutex_lock(&Parallel_idleLock);
+      pthread_cond_broadcast(&Parallel_idleCond);
+      pthread_mutex_unlock(&Parallel_idleLock);
+#endif
+    }
+    limit = newLimit;
+  }
+
+  /* Another processor is computing the first limit. */
+  if (0 == limit)
+    return s->numberOfProcs;
+  return limit;
+}
+
+void Parallel_elasticPark (void) {
+  GC_state s = pthread_getspecific (gcstate_key);
+  uint32_t epoch = __atomic_load_n(&Parallel_elasticEpoch, __ATOMIC_SEQ_CST);
+
+  if ((uint32_t)s->procNumber < Parallel_activeWorkers())
+    return;
+
+  struct timespec timeout = s->controls->elasticPeriod;
+
+  reclaimRemoteFrees(s);
+  maybeDecommitIdleBlocks(s);
+  HH_EBR_enterQuiescentState(s);
+  HM_EBR_enterQuiescentState(s);
+
+  struct timespec start;
+  timespec_now(&start);
+
+#if defined(__linux__)
+  syscall(SYS_futex, &Parallel_elasticEpoch, FUTEX_WAIT_PRIVATE, epoch,
+          &timeout, NULL, 0);
+#else
+  struct timespec deadline;
+  clock_gettime(CLOCK_REALTIME, &deadline);
+  timespec_add(&deadline, &timeout);
+  pthread_mutex_lock(&Parallel_idleLock);
+  if (epoch == __atomic_load_n(&Parallel_elasticEpoch, __ATOMIC_SEQ_CST))
+    pthread_cond_timedwait(&Parallel_idleCond, &Parallel_idleLock, &deadline);
+  pthread_mutex_unlock(&Parallel_idleLock);
+#endif
+
+  struct timespec stop;
+  timespec_now(&stop);
+  timespec_sub(&stop, &start);
+
+  HH_EBR_leaveQuiescentState(s);
+  HM_EBR_leaveQuiescentState(s);
+
+  s->cumulativeStatistics->numElasticParks++;
+  timespec_add(&(s->cumulativeStatistics->timeElasticParked), &stop);
+
+  GC_MayTerminateThread(s);
+}
@@ -16,6 +16,17 @@ PRIVATE Word64 Parallel_maxBytesLive (void);
 PRIVATE void Parallel_resetBytesLive (void);
 PRIVATE Word64 Parallel_getTimeInGC (void);
 
+PRIVATE Word32 Parallel_idlePrepare (void);
+PRIVATE void Parallel_idleCancel (void);
+PRIVATE void Parallel_idlePark (Word32 epoch, Word64 timeoutNanoseconds);
+PRIVATE void Parallel_idleWakeOne (void);
+
+/* The number of workers that should currently be running (all of them,
+ * unless elastic-workers is on), and where a worker beyond that number
+ * waits until it may be needed again. */
+PRIVATE Word32 Parallel_activeWorkers (void);
+PRIVATE void Parallel_elasticPark (void);
+
 PRIVATE Int8 Parallel_fetchAndAdd8 (pointer p, Int8 v);
 PRIVATE Int16 Parallel_fetchAndAdd16 (pointer p, Int16 v);
 PRIVATE Int32 Parallel_fetchAndAdd32 (pointer p, Int32 v);
@@ -40,3 +40,101 @@ void Proc_signalInitialization (GC_state s) {
 bool Proc_isInitialized (GC_state s) {
   return Proc_initializedCount == s->numberOfProcs;
 }
+
+uint32_t Proc_cpuOfProcessor (GC_state s, uint32_t proc) {
+  if (NULL != s->procCPUs)
+    return s->procCPUs[proc];
+  return proc * s->controls->affinityStride + s->controls->affinityBase;
+}
+
+/* Candidate CPUs in the order in which processors fill them: CPUs sharing
+ * a cache are adjacent, and caches on the same package are adjacent. */
+struct cpuInfo {
+  uint32_t cpu;
+  uint32_t package;
+  uint32_t cacheGroup;
+};
+
+static int compareCPUs (const void *x, const void *y) {
+  const struct cpuInfo *a = x;
+  const struct cpuInfo *b = y;
+  if (a->package != b->package)
+    return a->package < b->package ? -1 : 1;
+  if (a->cacheGroup != b->cacheGroup)
+    return a->cacheGroup < b->cacheGroup ? -1 : 1;
+  if (a->cpu != b->cpu)
+    return a->cpu < b->cpu ? -1 : 1;
+  return 0;
+}
+
+void Proc_initTopology (GC_state s) {
+  uint32_t P = s->numberOfProcs;
+
+  s->procCPUs = NULL;
+  s->procDistances = NULL;
+  if (not s->controls->setAffinity || P <= 1)
+    return;
+
+  uint32_t *cpus = (uint32_t *)malloc_safe(P * sizeof(uint32_t));
+  for (uint32_t p = 0; p < P; p++) {
+    cpus[p] = Proc_cpuOfProcessor(s, p);
+  }
+
+  /* With affinity-topology, choose the CPUs among those that set-affinity
+   * would allow (base, base+stride, ...) so that processors fill up one
+   * cache, then one package, before spilling onto the next. */
+  uint32_t numCPUs = GC_cpuCount();
+  uint32_t base = s->controls->affinityBase;
+  uint32_t stride = s->controls->affinityStride;
+  if (s->controls->affinityTopology && numCPUs > base && stride > 0) {
+    uint32_t n = (numCPUs - base + stride - 1) / stride;
+    struct cpuInfo *info =
+      (struct cpuInfo *)malloc_safe(n * sizeof(struct cpuInfo));
+    for (uint32_t k = 0; k < n; k++) {
+      uint32_t cpu = base + k * stride;
+      info[k].cpu = cpu;
+      info[k].package = GC_cpuPackage(cpu);
+      info[k].cacheGroup = GC_cpuCacheGroup(cpu);
+    }
+    qsort(info, n, sizeof(struct cpuInfo), compareCPUs);
+    /* More processors than CPUs: wrap around. */
+    for (uint32_t p = 0; p < P; p++) {
+      cpus[p] = info[p % n].cpu;
+    }
+    free(info);
+  }
+
+  uint32_t *packages = (uint32_t *)malloc_safe(P * sizeof(uint32_t));
+  uint32_t *caches = (uint32_t *)malloc_safe(P * sizeof(uint32_t));
+  for (uint32_t p = 0; p < P; p++) {
+    packages[p] = GC_cpuPackage(cpus[p]);
+    caches[p] = GC_cpuCacheGroup(cpus[p]);
+  }
+
+  uint8_t *distances = (uint8_t *)malloc_safe(P * P * sizeof(uint8_t));
+  for (uint32_t p = 0; p < P; p++) {
+    for (uint32_t q = 0; q < P; q++) {
+      uint8_t d = 2;
+      if (packages[p] == packages[q])
+        d = (caches[p] == caches[q]) ? 0 : 1;
+      distances[p * P + q] = d;
+    }
+    LOG(LM_PARALLEL, LL_INFO,
+      "processor %"PRIu32" on cpu %"PRIu32
+      " (package %"PRIu32", cache group %"PRIu32")",
+      p, cpus[p], packages[p], caches[p]);
+  }
+  free(packages);
+  free(caches);
+
+  s->procCPUs = cpus;
+  s->procDistances = distances;
+}
+
+uint32_t GC_processorDistance (GC_state s, uint32_t p, uint32_t q) {
+  if (NULL == s->procDistances
+      || p >= s->numberOfProcs
+      || q >= s->numberOfProcs)
+    return 2;
+  return s->procDistances[p * s->numberOfProcs + q];
+}
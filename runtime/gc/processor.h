@@ -15,6 +15,25 @@ void Proc_waitForInitialization (GC_state s);
 void Proc_signalInitialization (GC_state s);
 bool Proc_isInitialized (GC_state s);
 
+/* Decide which CPU each processor is pinned to, and record how close the
+ * processors are to each other. Called once, after the number of
+ * processors is known.
+ */
+void Proc_initTopology (GC_state s);
+
+/* The CPU that processor `proc` is pinned to with set-affinity */
+uint32_t Proc_cpuOfProcessor (GC_state s, uint32_t proc);
+
 #endif /* (defined (MLTON_GC_INTERNAL_FUNCS)) */
 
+#if (defined (MLTON_GC_INTERNAL_BASIS))
+
+/* How far apart processors p and q are: 0 if they share a last-level
+ * cache, 1 if they are on the same package, and 2 otherwise. Processors
+ * that are not pinned are always 2 apart.
+ */
+PRIVATE uint32_t GC_processorDistance (GC_state s, uint32_t p, uint32_t q);
+
+#endif /* MLTON_GC_INTERNAL_BASIS */
+
 #endif /* PROCESSOR_H_ */
@@ -265,89 +265,135 @@ bool frameIsPromotable(pointer cursor, GC_frameInfo fi) {
     return false;
 }
 
-pointer findPromotableFrame (GC_state s, GC_stack stack) {
-
-  pointer top = getStackTop(s, stack);
-  pointer bottom = getStackBottom(s, stack);
+static inline void initStackSporkFrames (GC_stack stack) {
+  stack->sporkFrames = NULL;
+  stack->sporkCapacity = 0;
+  stack->sporkCount = 0;
+  stack->sporkFirst = 0;
+}
 
-  size_t thisStackSize = (size_t)(top-bottom);
-  s->cumulativeStatistics->maxStackSizeForHeartbeat =
-    max(s->cumulativeStatistics->maxStackSizeForHeartbeat,
-        thisStackSize);
+/* For a stack that replaces `from`, whose frames were copied to the same
+ * offsets (see copyStack). */
+static inline void moveStackSporkFrames (GC_stack from, GC_stack to) {
+  to->sporkFrames = from->sporkFrames;
+  to->sporkCapacity = from->sporkCapacity;
+  to->sporkCount = from->sporkCount;
+  to->sporkFirst = from->sporkFirst;
+  initStackSporkFrames(from);
+}
 
-  size_t numFrames = 0;
+/* For a stack that is a copy of `from`, which stays in use. */
+static void copyStackSporkFrames (GC_stack from, GC_stack to) {
+  initStackSporkFrames(to);
+  if (0 == from->sporkCount)
+    return;
+  to->sporkFrames =
+    (size_t*)malloc_safe(from->sporkCount * sizeof(size_t));
+  memcpy(to->sporkFrames, from->sporkFrames, from->sporkCount * sizeof(size_t));
+  to->sporkCapacity = from->sporkCount;
+  to->sporkCount = from->sporkCount;
+  to->sporkFirst = from->sporkFirst;
+}
 
-  pointer oldestPromotableFrame = NULL;
+static inline void freeStackSporkFrames (GC_stack stack) {
+  free(stack->sporkFrames);
+  initStackSporkFrames(stack);
+}
 
-  // TODO: why do we search from top down, instead of bottom up?
-  pointer cursor = top;
-  while (cursor > bottom) {
-    numFrames++;
-    
-    GC_returnAddress ret = *((GC_returnAddress*)(cursor - GC_RETURNADDRESS_SIZE));
-    GC_frameInfo fi = getFrameInfoFromReturnAddress(s, ret);
-    if (frameIsPromotable(cursor, fi)) {
-        oldestPromotableFrame = cursor;
-    }
+/* Drop the entries of frames above offset. Those frames were popped without
+ * reaching their spoin, or have since been replaced by other frames. */
+static inline void dropSporkFramesAbove (GC_stack stack, size_t offset) {
+  while (stack->sporkCount > 0
+         && stack->sporkFrames[stack->sporkCount-1] > offset)
+    stack->sporkCount--;
+  if (stack->sporkFirst > stack->sporkCount)
+    stack->sporkFirst = stack->sporkCount;
+}
 
-    cursor = cursor - fi->size;
+void GC_sporkEnter (GC_state s, pointer frame) {
+  GC_stack stack = getStackCurrent(s);
+  size_t offset = (size_t)(frame - getStackBottom(s, stack));
+  dropSporkFramesAbove(stack, offset);
+
+  if (stack->sporkCount == stack->sporkCapacity) {
+    uint32_t newCapacity =
+      (0 == stack->sporkCapacity) ? 64 : 2 * stack->sporkCapacity;
+    size_t *newFrames =
+      (size_t*)realloc(stack->sporkFrames, newCapacity * sizeof(size_t));
+    if (NULL == newFrames)
+      DIE("Ran out of space for spork frames!");
+    stack->sporkFrames = newFrames;
+    stack->sporkCapacity = newCapacity;
   }
-
-  s->cumulativeStatistics->maxStackFramesWalkedForHeartbeat =
-    max(s->cumulativeStatistics->maxStackFramesWalkedForHeartbeat,
-        numFrames);
-
-  //if (oldestPromotableFrame == NULL) {
-  //  return NULL;
-  //}
-
-  // GC_returnAddress orig =
-  //   *((GC_returnAddress*)(oldestWaitingCFrame - GC_RETURNADDRESS_SIZE));
-  // GC_returnAddress left =
-  //   *((GC_returnAddress*)(oldestWaitingCFrame - 2*GC_RETURNADDRESS_SIZE));
-  // GC_returnAddress right =
-  //   *((GC_returnAddress*)(oldestWaitingCFrame - 3*GC_RETURNADDRESS_SIZE));
-
-  // LOG(LM_PARALLEL, LL_FORCE,
-  //   "oldest cont frame: orig "FMTRA", left "FMTRA", right "FMTRA,
-  //   orig,
-  //   left,
-  //   right);
-
-  return oldestPromotableFrame;
+  stack->sporkFrames[stack->sporkCount] = offset;
+  stack->sporkCount++;
 }
 
+void GC_spoinExit (GC_state s, pointer frame) {
+  GC_stack stack = getStackCurrent(s);
+  size_t offset = (size_t)(frame - getStackBottom(s, stack));
+  dropSporkFramesAbove(stack, offset);
+
+  /* A thread forked off a promoted frame starts with just that frame, and
+   * no entry for it. */
+  if (stack->sporkCount > 0
+      && stack->sporkFrames[stack->sporkCount-1] == offset)
+  {
+    stack->sporkCount--;
+    if (stack->sporkFirst > stack->sporkCount)
+      stack->sporkFirst = stack->sporkCount;
+  }
+}
 
-pointer findYoungestPromotableFrame (GC_state s, GC_stack stack) {
+/* The handler frame starts at stackTop. Its own entries are dropped along
+ * with those of the frames above it, because we don't know its size here;
+ * that only loses the chance to promote it. */
+void GC_sporkUnwind (GC_state s, pointer stackTop) {
+  GC_stack stack = getStackCurrent(s);
+  dropSporkFramesAbove(stack, (size_t)(stackTop - getStackBottom(s, stack)));
+}
 
-  pointer top = getStackTop(s, stack);
+/* The oldest unpromoted spork frame is normally promotable, so this looks at
+ * one entry. The stack is suspended, so every entry is the top of a frame
+ * with a return address. */
+pointer findPromotableFrame (GC_state s, GC_stack stack) {
   pointer bottom = getStackBottom(s, stack);
 
-  size_t thisStackSize = (size_t)(top-bottom);
   s->cumulativeStatistics->maxStackSizeForHeartbeat =
     max(s->cumulativeStatistics->maxStackSizeForHeartbeat,
-        thisStackSize);
-
-  pointer youngestPromotableFrame = NULL;
+        stack->used);
 
+  pointer oldestPromotableFrame = NULL;
   size_t numFrames = 0;
 
-  pointer cursor = top;
-  while (cursor > bottom && youngestPromotableFrame == NULL) {
+  for (uint32_t i = stack->sporkFirst;
+       i < stack->sporkCount && oldestPromotableFrame == NULL;
+       i++)
+  {
+    assert(stack->sporkFrames[i] <= stack->used);
     numFrames++;
 
+    pointer cursor = bottom + stack->sporkFrames[i];
     GC_returnAddress ret = *((GC_returnAddress*)(cursor - GC_RETURNADDRESS_SIZE));
     GC_frameInfo fi = getFrameInfoFromReturnAddress(s, ret);
     if (frameIsPromotable(cursor, fi)) {
-        youngestPromotableFrame = cursor;
-    }    
-
-    cursor = cursor - fi->size;
+      oldestPromotableFrame = cursor;
+    }
   }
 
   s->cumulativeStatistics->maxStackFramesWalkedForHeartbeat =
     max(s->cumulativeStatistics->maxStackFramesWalkedForHeartbeat,
         numFrames);
 
-  return youngestPromotableFrame;
+  return oldestPromotableFrame;
+}
+
+void promoteSporkFrame (GC_state s, GC_stack stack, pointer frame) {
+  size_t offset = (size_t)(frame - getStackBottom(s, stack));
+  uint32_t i = stack->sporkFirst;
+  while (stack->sporkFrames[i] != offset) {
+    i++;
+    assert(i < stack->sporkCount);
+  }
+  stack->sporkFirst = i + 1;
 }
@@ -13,29 +13,33 @@
  * Stack objects have the following layout:
  *
  * header ::
- * markTop (native-pointer) ::
- * markIndex (word32) ::
+ * lastUsed (size_t) ::
+ * suspendedCollections (word32) ::
+ * sporkCapacity (word32) ::
  * reserved ::
  * used ::
+ * sporkFrames (size_t*) ::
+ * sporkCount (word32) ::
+ * sporkFirst (word32) ::
  * ... reserved bytes ...
  *
- * The markTop and markIndex are used by the mark-compact GC.  The
+ * The lastUsed and suspendedCollections are used by local collections
+ * to find stacks that have stayed suspended (see LGC_shrinkStack).  The
  * reserved size gives the number of bytes for the stack (before the
  * next ML object).  The used size gives the number of bytes currently
  * used by the stack.  The sequence of reserved bytes correspond to ML
  * stack frames, which will be discussed in more detail in "frame.h".
 */
 typedef struct GC_stack {
-  /* markTop and markIndex are only used during marking.  They record
-   * the current pointer in the stack that is being followed.  markTop
-   * points to the top of the stack frame containing the pointer and
-   * markIndex is the index in that frame's frameOffsets of the pointer
-   * slot.  So, when the GC pointer reversal gets back to the stack,
-   * it can continue with the next pointer (either in the current
-   * frame or the next frame).
+  /* These took the place of the mark-compact fields (markTop and
+   * markIndex), so the layout is unchanged.  lastUsed is the used size
+   * seen by the last local collection that moved this stack, and
+   * suspendedCollections is the number of consecutive local collections
+   * that saw it suspended with that same used size.
    */
-  pointer markTop;
-  uint32_t markIndex;
+  size_t lastUsed;
+  uint32_t suspendedCollections;
+  uint32_t sporkCapacity;
   /* reserved is the number of bytes reserved for stack,
    * i.e. its maximum size.
    */
@@ -44,6 +48,17 @@ typedef struct GC_stack {
    * Stacks with used == reserved are continuations.
    */
   size_t used;
+  /* The frames of the sporks that are currently entered on this stack, as
+   * offsets of their tops from the bottom of the stack, oldest first.
+   * Generated code pushes an entry when it enters a spork and pops it at the
+   * matching spoin (see GC_sporkEnter and GC_spoinExit), so the heartbeat
+   * handler can find promotable frames without walking the stack. Entries
+   * below sporkFirst have already been promoted.  The array is malloc'd
+   * and owned by the stack.
+   */
+  size_t *sporkFrames;
+  uint32_t sporkCount;
+  uint32_t sporkFirst;
   /* The next address is the bottom of the stack, and the following
    * reserved bytes hold space for the stack.
    */
@@ -80,12 +95,31 @@ static inline size_t sizeofStackMinimumReserved (GC_state s, GC_stack stack);
 static inline size_t sizeofStackGrowReserved (GC_state s, GC_stack stack);
 static inline size_t sizeofStackShrinkReserved (GC_state s, GC_stack stack, bool current);
 
+static inline void initStackSporkFrames (GC_stack stack);
+static inline void moveStackSporkFrames (GC_stack from, GC_stack to);
+static void copyStackSporkFrames (GC_stack from, GC_stack to);
+static inline void freeStackSporkFrames (GC_stack stack);
+
 // pointer to frame that is promotable, or NULL if no such frame
 pointer findPromotableFrame (GC_state s, GC_stack stack);
-pointer findYoungestPromotableFrame (GC_state s, GC_stack stack);
+/* Marks `frame`, as returned by findPromotableFrame, and every older spork
+ * frame of `stack` as promoted. */
+void promoteSporkFrame (GC_state s, GC_stack stack, pointer frame);
 
 void copyStackFrameToNewStack (GC_state s, pointer frame, GC_stack from, GC_stack to);
 
 static inline void copyStack (GC_state s, GC_stack from, GC_stack to);
 
 #endif /* (defined (MLTON_GC_INTERNAL_FUNCS)) */
+
+#if (defined (MLTON_GC_INTERNAL_BASIS))
+
+/* Called by generated code with the top of the current frame, on entering a
+ * spork and at its spoin. */
+PRIVATE void GC_sporkEnter (GC_state s, pointer frame);
+PRIVATE void GC_spoinExit (GC_state s, pointer frame);
+/* Called by generated code after a raise has cut the current stack back to
+ * stackTop. */
+PRIVATE void GC_sporkUnwind (GC_state s, pointer stackTop);
+
+#endif /* (defined (MLTON_GC_INTERNAL_BASIS)) */
@@ -70,7 +70,29 @@ struct GC_cumulativeStatistics *newCumulativeStatistics(void) {
   cumulativeStatistics->numMarkCompactGCs = 0;
   cumulativeStatistics->numMinorGCs = 0;
   cumulativeStatistics->numHHLocalGCs = 0;
+  cumulativeStatistics->numParallelLocalGCs = 0;
+  cumulativeStatistics->numLocalGCHelpers = 0;
+  cumulativeStatistics->numLocalGCsHelped = 0;
+  cumulativeStatistics->numIdleParks = 0;
+  cumulativeStatistics->numIdleWakeups = 0;
+  cumulativeStatistics->numElasticParks = 0;
+  cumulativeStatistics->numWeaksCleared = 0;
+  cumulativeStatistics->numBlocksFreedForOthers = 0;
+  cumulativeStatistics->numRemoteFreeBatches = 0;
+  cumulativeStatistics->numBlocksReclaimedFromOthers = 0;
+  cumulativeStatistics->numStacksShrunk = 0;
+  cumulativeStatistics->numStacksHibernated = 0;
+  cumulativeStatistics->bytesReclaimedFromStacks = 0;
+  cumulativeStatistics->numActiveWorkerChanges = 0;
+  cumulativeStatistics->bytesCopiedHelpingLocalGC = 0;
   cumulativeStatistics->numCCs = 0;
+  cumulativeStatistics->numStacksPooled = 0;
+  cumulativeStatistics->numStackPoolHits = 0;
+  cumulativeStatistics->numStackPoolMisses = 0;
+  cumulativeStatistics->numParallelCCs = 0;
+  cumulativeStatistics->numCCHelpers = 0;
+  cumulativeStatistics->numCCsHelped = 0;
+  cumulativeStatistics->bytesMarkedHelpingCC = 0;
   cumulativeStatistics->numDisentanglementChecks = 0;
   cumulativeStatistics->numEntanglements = 0;
   cumulativeStatistics->numChecksSkipped = 0;
@@ -85,8 +107,25 @@ struct GC_cumulativeStatistics *newCumulativeStatistics(void) {
   cumulativeStatistics->timeLocalGC.tv_nsec = 0;
   cumulativeStatistics->timeLocalPromo.tv_sec = 0;
   cumulativeStatistics->timeLocalPromo.tv_nsec = 0;
+  cumulativeStatistics->timeLocalGCParallelScan.tv_sec = 0;
+  cumulativeStatistics->timeLocalGCParallelScan.tv_nsec = 0;
+  cumulativeStatistics->timeLocalGCParallelWork.tv_sec = 0;
+  cumulativeStatistics->timeLocalGCParallelWork.tv_nsec = 0;
   cumulativeStatistics->timeCC.tv_sec = 0;
   cumulativeStatistics->timeCC.tv_nsec = 0;
+  cumulativeStatistics->timeCCParallelMark.tv_sec = 0;
+  cumulativeStatistics->timeCCParallelMark.tv_nsec = 0;
+  cumulativeStatistics->timeCCParallelWork.tv_sec = 0;
+  cumulativeStatistics->timeCCParallelWork.tv_nsec = 0;
+  cumulativeStatistics->timeIdleParked.tv_sec = 0;
+  cumulativeStatistics->timeIdleParked.tv_nsec = 0;
+  cumulativeStatistics->timeElasticParked.tv_sec = 0;
+  cumulativeStatistics->timeElasticParked.tv_nsec = 0;
+
+  cumulativeStatistics->collectionThresholdRatio = 0.0;
+  cumulativeStatistics->minCollectionThresholdRatio = 0.0;
+  cumulativeStatistics->maxCollectionThresholdRatio = 0.0;
+  cumulativeStatistics->numCollectionThresholdAdjustments = 0;
 
   rusageZero (&cumulativeStatistics->ru_gc);
   rusageZero (&cumulativeStatistics->ru_gcCopying);
@@ -272,6 +311,174 @@ void S_outputCumulativeStatisticsJSON(
     fprintf(out, ", ");
 
     fprintf(out, "\"bytesHashConsed\" : %"PRIuMAX, statistics->bytesHashConsed);
+
+    fprintf(out, ", ");
+
+    fprintf(out, "\"numHashConsGCs\" : %"PRIuMAX, statistics->numHashConsGCs);
+
+    fprintf(out, ", ");
+
+    fprintf(out, "\"numWeaksCleared\" : %"PRIuMAX, statistics->numWeaksCleared);
+
+    fprintf(out, ", ");
+
+    fprintf(out, "\"numStacksShrunk\" : %"PRIuMAX, statistics->numStacksShrunk);
+
+    fprintf(out, ", ");
+
+    fprintf(out, "\"numStacksHibernated\" : %"PRIuMAX, statistics->numStacksHibernated);
+
+    fprintf(out, ", ");
+
+    fprintf(out, "\"bytesReclaimedFromStacks\" : %"PRIuMAX, statistics->bytesReclaimedFromStacks);
+
+    fprintf(out, ", ");
+
+    fprintf(out, "\"numBlocksFreedForOthers\" : %"PRIuMAX, statistics->numBlocksFreedForOthers);
+
+    fprintf(out, ", ");
+
+    fprintf(out, "\"numRemoteFreeBatches\" : %"PRIuMAX, statistics->numRemoteFreeBatches);
+
+    fprintf(out, ", ");
+
+    fprintf(out, "\"numBlocksReclaimedFromOthers\" : %"PRIuMAX, statistics->numBlocksReclaimedFromOthers);
+
+    fprintf(out, ", ");
+
+    fprintf(out,
+            "\"numParallelLocalGCs\" : %"PRIuMAX,
+            statistics->numParallelLocalGCs);
+
+    fprintf(out, ", ");
+
+    fprintf(out,
+            "\"numLocalGCHelpers\" : %"PRIuMAX,
+            statistics->numLocalGCHelpers);
+
+    fprintf(out, ", ");
+
+    fprintf(out,
+            "\"numLocalGCsHelped\" : %"PRIuMAX,
+            statistics->numLocalGCsHelped);
+
+    fprintf(out, ", ");
+
+    fprintf(out,
+            "\"bytesCopiedHelpingLocalGC\" : %"PRIuMAX,
+            statistics->bytesCopiedHelpingLocalGC);
+
+    fprintf(out, ", ");
+
+    fprintf(out,
+            "\"localGCParallelScanTime\" : %"PRIuMAX,
+            (uintmax_t)statistics->timeLocalGCParallelScan.tv_sec * 1000
+            + (uintmax_t)statistics->timeLocalGCParallelScan.tv_nsec / 1000000);
+
+    fprintf(out, ", ");
+
+    fprintf(out,
+            "\"localGCParallelWorkTime\" : %"PRIuMAX,
+            (uintmax_t)statistics->timeLocalGCParallelWork.tv_sec * 1000
+            + (uintmax_t)statistics->timeLocalGCParallelWork.tv_nsec / 1000000);
+
+    fprintf(out, ", ");
+
+    fprintf(out, "\"numParallelCCs\" : %"PRIuMAX, statistics->numParallelCCs);
+
+    fprintf(out, ", ");
+
+    fprintf(out, "\"numCCHelpers\" : %"PRIuMAX, statistics->numCCHelpers);
+
+    fprintf(out, ", ");
+
+    fprintf(out, "\"numCCsHelped\" : %"PRIuMAX, statistics->numCCsHelped);
+
+    fprintf(out, ", ");
+
+    fprintf(out,
+            "\"bytesMarkedHelpingCC\" : %"PRIuMAX,
+            statistics->bytesMarkedHelpingCC);
+
+    fprintf(out, ", ");
+
+    fprintf(out,
+            "\"ccParallelMarkTime\" : %"PRIuMAX,
+            (uintmax_t)statistics->timeCCParallelMark.tv_sec * 1000
+            + (uintmax_t)statistics->timeCCParallelMark.tv_nsec / 1000000);
+
+    fprintf(out, ", ");
+
+    fprintf(out,
+            "\"ccParallelWorkTime\" : %"PRIuMAX,
+            (uintmax_t)statistics->timeCCParallelWork.tv_sec * 1000
+            + (uintmax_t)statistics->timeCCParallelWork.tv_nsec / 1000000);
+
+    fprintf(out, ", ");
+
+    fprintf(out, "\"numStacksPooled\" : %"PRIuMAX, statistics->numStacksPooled);
+
+    fprintf(out, ", ");
+
+    fprintf(out, "\"numStackPoolHits\" : %"PRIuMAX, statistics->numStackPoolHits);
+
+    fprintf(out, ", ");
+
+    fprintf(out, "\"numStackPoolMisses\" : %"PRIuMAX, statistics->numStackPoolMisses);
+
+    fprintf(out, ", ");
+
+    fprintf(out, "\"numIdleParks\" : %"PRIuMAX, statistics->numIdleParks);
+
+    fprintf(out, ", ");
+
+    fprintf(out, "\"numIdleWakeups\" : %"PRIuMAX, statistics->numIdleWakeups);
+
+    fprintf(out, ", ");
+
+    fprintf(out,
+            "\"idleParkedTime\" : %"PRIuMAX,
+            (uintmax_t)statistics->timeIdleParked.tv_sec * 1000
+            + (uintmax_t)statistics->timeIdleParked.tv_nsec / 1000000);
+
+    fprintf(out, ", ");
+
+    fprintf(out, "\"numElasticParks\" : %"PRIuMAX, statistics->numElasticParks);
+
+    fprintf(out, ", ");
+
+    fprintf(out, "\"numActiveWorkerChanges\" : %"PRIuMAX, statistics->numActiveWorkerChanges);
+
+    fprintf(out, ", ");
+
+    fprintf(out,
+            "\"elasticParkedTime\" : %"PRIuMAX,
+            (uintmax_t)statistics->timeElasticParked.tv_sec * 1000
+            + (uintmax_t)statistics->timeElasticParked.tv_nsec / 1000000);
+
+    fprintf(out, ", ");
+
+    fprintf(out,
+            "\"collectionThresholdRatio\" : %.3f",
+            statistics->collectionThresholdRatio);
+
+    fprintf(out, ", ");
+
+    fprintf(out,
+            "\"minCollectionThresholdRatio\" : %.3f",
+            statistics->minCollectionThresholdRatio);
+
+    fprintf(out, ", ");
+
+    fprintf(out,
+            "\"maxCollectionThresholdRatio\" : %.3f",
+            statistics->maxCollectionThresholdRatio);
+
+    fprintf(out, ", ");
+
+    fprintf(out,
+            "\"numCollectionThresholdAdjustments\" : %"PRIuMAX,
+            statistics->numCollectionThresholdAdjustments);
   }
   fprintf(out, " }");
 }
@@ -67,7 +67,29 @@ struct GC_cumulativeStatistics {
   uintmax_t numMarkCompactGCs;
   uintmax_t numMinorGCs;
   uintmax_t numHHLocalGCs;
+  uintmax_t numParallelLocalGCs;    // local GCs that invited helpers
+  uintmax_t numLocalGCHelpers;      // sum of helpers joined, over all depths
+  uintmax_t numLocalGCsHelped;      // times this proc helped another's LGC
+  uintmax_t numIdleParks;           // times this proc parked while idle
+  uintmax_t numWeaksCleared;        // weak pointers cleared by local collections
+  uintmax_t numBlocksFreedForOthers; // blocks freed here, owned by another proc
+  uintmax_t numRemoteFreeBatches;    // ... published as this many lists
+  uintmax_t numBlocksReclaimedFromOthers; // blocks freed elsewhere, owned here
+  uintmax_t numStacksShrunk;        // stacks moved into a smaller chunk
+  uintmax_t numStacksHibernated;    // ... of which were compacted to their used size
+  uintmax_t bytesReclaimedFromStacks;
+  uintmax_t numElasticParks;        // times this proc parked as a surplus worker
+  uintmax_t numActiveWorkerChanges; // times this proc changed the active worker count
+  uintmax_t numIdleWakeups;         // times this proc woke a parked proc
+  uintmax_t bytesCopiedHelpingLocalGC;
   uintmax_t numCCs;
+  uintmax_t numStacksPooled;        // stacks of joined threads kept for reuse
+  uintmax_t numStackPoolHits;       // new threads that reused a pooled stack
+  uintmax_t numStackPoolMisses;     // new threads that allocated a stack
+  uintmax_t numParallelCCs;         // CCs that invited helpers
+  uintmax_t numCCHelpers;           // sum of helpers joined, over all loops
+  uintmax_t numCCsHelped;           // times this proc helped another's CC
+  uintmax_t bytesMarkedHelpingCC;
   uintmax_t numDisentanglementChecks; // count full read barriers
   uintmax_t numEntanglements;         // count instances entanglement is detected
   uintmax_t numChecksSkipped;
@@ -81,8 +103,32 @@ struct GC_cumulativeStatistics {
   struct timespec timeLocalGC;
   struct timespec timeLocalPromo;
 
+  /* For local GCs with helpers: elapsed time of the parallel scan phases,
+   * and the total busy time of all participants during those phases. The
+   * ratio is the speedup achieved. */
+  struct timespec timeLocalGCParallelScan;
+  struct timespec timeLocalGCParallelWork;
+
   struct timespec timeCC;
 
+  /* Likewise for CCs with helpers, during their mark and unmark loops. */
+  struct timespec timeCCParallelMark;
+  struct timespec timeCCParallelWork;
+
+  /* Total time parked (blocked in the kernel) while idle. */
+  struct timespec timeIdleParked;
+
+  /* Total time parked as a surplus worker (elastic-workers). */
+  struct timespec timeElasticParked;
+
+  /* Collection threshold ratios chosen by the gc-overhead policy (see
+   * HM_HH_adjustCollectionThreshold) on this processor: the latest one and
+   * the range so far (all 0 if the policy never ran). */
+  double collectionThresholdRatio;
+  double minCollectionThresholdRatio;
+  double maxCollectionThresholdRatio;
+  uintmax_t numCollectionThresholdAdjustments;
+
   struct rusage ru_gc; /* total resource usage in gc. */
   struct rusage ru_gcCopying; /* resource usage in major copying gcs. */
   struct rusage ru_gcMarkCompact; /* resource usage in major mark-compact gcs. */
@@ -345,6 +345,11 @@ void GC_HH_joinIntoParent(
   assert(child != NULL);
   assert(child->hierarchicalHeap != NULL);
 
+  /* The child has finished, so its stack can be reused by the next new
+   * thread on this processor. */
+  if (BOGUS_OBJPTR != child->stack)
+    freeStackSporkFrames((GC_stack)objptrToPointer(child->stack, NULL));
+  poolThreadStack(s, child);
   HM_HH_merge(s, thread, child);
 
   /* ======================================================================== */
@@ -400,8 +405,7 @@ bool GC_HH_canForkThread(GC_state s, pointer threadp) {
   enter(s);
   GC_thread thread = threadObjptrToStruct(s, pointerToObjptr(threadp, NULL));
   GC_stack fromStack = (GC_stack)objptrToPointer(thread->stack, NULL);
-  // pointer pframe = findPromotableFrame(s, fromStack);
-  pointer pframe = findYoungestPromotableFrame(s, fromStack);
+  pointer pframe = findPromotableFrame(s, fromStack);
   leave(s);
   return NULL != pframe;
 }
@@ -434,6 +438,7 @@ objptr GC_HH_forkThread(GC_state s, pointer threadp, pointer dp) {
 
   objptr dop = pointerToObjptr(dp, NULL);
   *((objptr*)(pframe - GC_RETURNADDRESS_SIZE - OBJPTR_SIZE * (nesting + 1))) = dop;
+  promoteSporkFrame(s, fromStack, pframe);
 
   /* SAM_NOTE: VERY SUBTLE: the next line (which updates the pframe's return
    * address) absolutely must happen before we call newThread. This is because
@@ -32,10 +32,33 @@ size_t offsetofWeak (GC_state s) {
   return (sizeofWeak (s)) - (GC_NORMAL_METADATA_SIZE + sizeof (struct GC_weak));
 }
 
+/* A weak is cleared by replacing only the type index in its header, because
+ * the collector that clears it might still need its mark and pin bits. */
+bool isWeakGone (GC_header header) {
+  return (header & TYPE_INDEX_MASK) == (GC_WEAK_GONE_HEADER & TYPE_INDEX_MASK);
+}
+
+/* Returns true if this call cleared the weak. A weak can be cleared
+ * concurrently by a collection and by GC_weakGet (see CC_weakGetBarrier). */
+bool tryClearWeak (GC_state s, pointer p) {
+  GC_header *headerp = getHeaderp (p);
+  GC_header header = *headerp;
+  while (not (isWeakGone (header))) {
+    GC_header newHeader =
+      (header & ~TYPE_INDEX_MASK) | (GC_WEAK_GONE_HEADER & TYPE_INDEX_MASK);
+    if (__sync_bool_compare_and_swap (headerp, header, newHeader)) {
+      ((GC_weak)(p + offsetofWeak (s)))->objptr = BOGUS_OBJPTR;
+      return TRUE;
+    }
+    header = *headerp;
+  }
+  return FALSE;
+}
+
 uint32_t GC_weakCanGet (GC_state s, pointer p) {
   uint32_t res;
 
-  res = GC_WEAK_GONE_HEADER != getHeader (p);
+  res = not (isWeakGone (getHeader (p)));
   if (DEBUG_WEAK)
     fprintf (stderr, "%s = GC_weakCanGet ("FMTPTR") [%d]\n",
              boolToString (res), (uintptr_t)p,
@@ -48,7 +71,11 @@ pointer GC_weakGet (GC_state s, pointer p) {
   pointer res;
 
   weak = (GC_weak)(p + offsetofWeak (s));
-  res = objptrToPointer(weak->objptr, NULL);
+  objptr op = weak->objptr;
+  res = objptrToPointer(op, NULL);
+  /* The canGet that follows reports whether `res` may be used. */
+  if (isObjptr (op) and not (isWeakGone (getHeader (p))))
+    CC_weakGetBarrier (s, p, res);
   if (DEBUG_WEAK)
     fprintf (stderr, FMTPTR" = GC_weakGet ("FMTPTR") [%d]\n",
              (uintptr_t)res, (uintptr_t)p,
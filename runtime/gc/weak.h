@@ -49,6 +49,8 @@ COMPILE_TIME_ASSERT(GC_weak__packed,
 
 static inline size_t sizeofWeak (GC_state s);
 static inline size_t offsetofWeak (GC_state s);
+static inline bool isWeakGone (GC_header header);
+static bool tryClearWeak (GC_state s, pointer p);
 
 #endif /* (defined (MLTON_GC_INTERNAL_FUNCS)) */
 
@@ -58,6 +58,7 @@ int main (__attribute__ ((unused)) int argc,
   MkSize (sequenceMetaData, GC_SEQUENCE_METADATA_SIZE);
 
   MkGCFieldOffset (atomicState);
+  MkGCFieldOffset (blockMask);
   MkGCFieldOffset (exnStack);
   MkGCFieldOffset (frontier);
   MkGCFieldOffset (limit);
@@ -68,6 +69,7 @@ int main (__attribute__ ((unused)) int argc,
   MkGCFieldOffset (stackBottom);
   MkGCFieldOffset (stackLimit);
   MkGCFieldOffset (stackTop);
+  MkGCFieldOffset (writeBarrierLevelHead);
 
   MkStrConst (MLton_Platform_Arch_host);
   MkStrConst (MLton_Platform_OS_host);
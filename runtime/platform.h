@@ -143,10 +143,51 @@ PRIVATE void *GC_mmapAnonFlags_safe_protect (void *start, size_t length,
                                              size_t dead_high);
 PRIVATE void *GC_mremap (void *start, size_t oldLength, size_t newLength);
 PRIVATE void GC_release (void *base, size_t length);
+/* Give the physical pages of [base, base+length) back to the OS, keeping
+ * the mapping. The contents become undefined (zero, on most systems).
+ * Returns false if the pages could not be released (they stay resident).
+ */
+PRIVATE bool GC_decommit (void *base, size_t length);
 
 PRIVATE size_t GC_pageSize (void);
 PRIVATE uintmax_t GC_physMem (void);
 
+/* NUMA placement. These are best-effort: on platforms without NUMA
+ * support, there is a single node 0 and GC_numaBind does nothing.
+ */
+PRIVATE uint32_t GC_numaNumNodes (void);
+PRIVATE uint32_t GC_numaNodeOfCPU (uint32_t cpu);
+PRIVATE uint32_t GC_numaNodeOfAddress (void *p);
+PRIVATE void GC_numaBind (void *start, size_t length, uint32_t node);
+
+/* CPU topology. GC_cpuCount is one more than the highest-numbered online
+ * CPU, or 0 if unknown. GC_cpuPackage is the physical package (socket) of a CPU, and
+ * GC_cpuCacheGroup identifies the set of CPUs sharing its last-level cache,
+ * by the lowest-numbered CPU in that set. Without topology information,
+ * every CPU is in package 0 and in a cache group of its own.
+ */
+PRIVATE uint32_t GC_cpuCount (void);
+PRIVATE uint32_t GC_cpuPackage (uint32_t cpu);
+PRIVATE uint32_t GC_cpuCacheGroup (uint32_t cpu);
+
+/* The CPU bandwidth this process may use, in CPUs (e.g. 2.5 for a cgroup
+ * with a quota of 250ms per 100ms period), or 0 if unlimited or unknown.
+ * This is read anew on every call, since the quota may change.
+ */
+PRIVATE double GC_cpuQuota (void);
+
+/* Huge pages. GC_hugePageSize is 0 if huge pages are not supported.
+ * GC_mmapAnonHuge maps explicitly reserved huge pages (returning (void*)-1
+ * if there are none), while GC_adviseHugePages asks for transparent huge
+ * pages on an existing mapping. GC_hugePageResidentBytes is the amount of
+ * memory of this process that is currently backed by huge pages of either
+ * kind, or 0 if unknown.
+ */
+PRIVATE size_t GC_hugePageSize (void);
+PRIVATE void *GC_mmapAnonHuge (void *start, size_t length);
+PRIVATE void GC_adviseHugePages (void *start, size_t length);
+PRIVATE uintmax_t GC_hugePageResidentBytes (void);
+
 PRIVATE void GC_setCygwinUseMmap (bool b);
 
 PRIVATE void GC_diskBack_close (void *data);
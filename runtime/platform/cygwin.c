@@ -8,6 +8,8 @@
 #endif
 #include "platform/windows.c"
 #include "platform/mremap.c"
+#include "platform/hugepage.none.c"
+#include "platform/numa.none.c"
 
 /* 
  * The sysconf(_SC_PAGESIZE) is the necessary alignment for using
@@ -10,6 +10,8 @@
 #include "platform/diskBack.unix.c"
 #include "platform/mmap-protect.c"
 #include "platform/nonwin.c"
+#include "platform/hugepage.none.c"
+#include "platform/numa.none.c"
 #include "platform/recv.nonblock.c"
 #include "platform/setenv.putenv.c"
 #include "platform/use-mmap.c"
@@ -0,0 +1,16 @@
+size_t GC_hugePageSize (void) {
+  return 0;
+}
+
+void *GC_mmapAnonHuge (__attribute__ ((unused)) void *start,
+                       __attribute__ ((unused)) size_t length) {
+  return (void*)-1;
+}
+
+void GC_adviseHugePages (__attribute__ ((unused)) void *start,
+                         __attribute__ ((unused)) size_t length) {
+}
+
+uintmax_t GC_hugePageResidentBytes (void) {
+  return 0;
+}
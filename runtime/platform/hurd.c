@@ -6,6 +6,8 @@
 #include "platform/displayMem.proc.c"
 #include "platform/mmap-protect.c"
 #include "platform/nonwin.c"
+#include "platform/hugepage.none.c"
+#include "platform/numa.none.c"
 #include "platform/use-mmap.c"
 #include "platform/sysconf.c"
 #include "platform/mremap.c"
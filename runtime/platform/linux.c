@@ -3,6 +3,9 @@
 
 #include "platform.h"
 
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+
 #include "platform/diskBack.unix.c"
 #include "platform/displayMem.proc.c"
 #include "platform/mmap-protect.c"
@@ -31,3 +34,241 @@ uintmax_t GC_physMem (void) {
         
         return (uintmax_t)si.totalram * (uintmax_t)si.mem_unit;
 }
+
+/* NUMA topology is read from sysfs rather than through libnuma, so that
+ * programs do not need to link against it. */
+uint32_t GC_numaNumNodes (void) {
+        static uint32_t numNodes = 0;
+        unsigned int lo, hi;
+        FILE *f;
+
+        if (numNodes > 0)
+                return numNodes;
+
+        numNodes = 1;
+        f = fopen ("/sys/devices/system/node/possible", "r");
+        if (NULL == f)
+                return numNodes;
+        /* The file contains a range such as "0-1", or just "0". */
+        switch (fscanf (f, "%u-%u", &lo, &hi)) {
+        case 2:
+                numNodes = hi + 1;
+                break;
+        case 1:
+                numNodes = lo + 1;
+                break;
+        default:
+                break;
+        }
+        fclose (f);
+        return numNodes;
+}
+
+uint32_t GC_numaNodeOfCPU (uint32_t cpu) {
+        char path[128];
+        struct stat st;
+
+        for (uint32_t node = 0; node < GC_numaNumNodes (); node++) {
+                snprintf (path, sizeof (path),
+                          "/sys/devices/system/cpu/cpu%"PRIu32"/node%"PRIu32,
+                          cpu, node);
+                if (0 == stat (path, &st))
+                        return node;
+        }
+        return 0;
+}
+
+uint32_t GC_numaNodeOfAddress (void *p) {
+        int node = 0;
+
+        if (0 != syscall (SYS_get_mempolicy, &node, NULL, 0, p,
+                          MPOL_F_NODE | MPOL_F_ADDR))
+                return 0;
+        return (uint32_t)node;
+}
+
+void GC_numaBind (void *start, size_t length, uint32_t node) {
+        unsigned long mask[4] = {0, 0, 0, 0};
+        size_t bitsPerWord = 8 * sizeof (unsigned long);
+
+        if (node >= 4 * bitsPerWord)
+                return;
+        mask[node / bitsPerWord] = 1UL << (node % bitsPerWord);
+        /* MPOL_PREFERRED, so that we fall back on other nodes rather than
+         * failing when this node runs out of memory. Failure to bind is
+         * harmless: the pages are then placed by first touch. */
+        syscall (SYS_mbind, start, length, MPOL_PREFERRED,
+                 mask, 4 * bitsPerWord + 1, 0);
+}
+
+uint32_t GC_cpuCount (void) {
+        static uint32_t numCPUs = 0;
+        char line[256];
+        char *last;
+        unsigned int hi;
+        FILE *f;
+
+        if (numCPUs > 0)
+                return numCPUs;
+
+        f = fopen ("/sys/devices/system/cpu/online", "r");
+        if (NULL == f)
+                return numCPUs;
+        /* A list of ranges such as "0-3,8-11"; the last number is the
+         * highest online CPU. */
+        if (NULL != fgets (line, sizeof (line), f)) {
+                last = line;
+                for (char *c = line; '\0' != *c; c++)
+                        if (',' == *c || '-' == *c)
+                                last = c + 1;
+                if (1 == sscanf (last, "%u", &hi))
+                        numCPUs = hi + 1;
+        }
+        fclose (f);
+        return numCPUs;
+}
+
+uint32_t GC_cpuPackage (uint32_t cpu) {
+        char path[128];
+        unsigned int package;
+        FILE *f;
+
+        snprintf (path, sizeof (path),
+                  "/sys/devices/system/cpu/cpu%"PRIu32
+                  "/topology/physical_package_id", cpu);
+        f = fopen (path, "r");
+        if (NULL == f)
+                return 0;
+        if (1 != fscanf (f, "%u", &package))
+                package = 0;
+        fclose (f);
+        return (uint32_t)package;
+}
+
+/* The caches of a CPU are listed as cache/index0, index1, ... with the
+ * last-level cache last. Its shared_cpu_list is a list of ranges such as
+ * "0-7,64-71"; the first number is the lowest CPU sharing the cache. */
+uint32_t GC_cpuCacheGroup (uint32_t cpu) {
+        char path[128];
+        unsigned int first;
+        uint32_t group = cpu;
+        FILE *f;
+
+        for (uint32_t index = 0; ; index++) {
+                snprintf (path, sizeof (path),
+                          "/sys/devices/system/cpu/cpu%"PRIu32
+                          "/cache/index%"PRIu32"/shared_cpu_list",
+                          cpu, index);
+                f = fopen (path, "r");
+                if (NULL == f)
+                        break;
+                if (1 == fscanf (f, "%u", &first))
+                        group = (uint32_t)first;
+                fclose (f);
+        }
+        return group;
+}
+
+/* With cgroup v2, /proc/self/cgroup contains a line "0::<path>", and the
+ * quota of the cgroup is in /sys/fs/cgroup/<path>/cpu.max as
+ * "<quota> <period>", or "max <period>" if there is none. A quota on an
+ * ancestor cgroup applies too, so the smallest one on the path wins. */
+double GC_cpuQuota (void) {
+        char line[512];
+        char cgroup[256];
+        char path[512];
+        char quota[32];
+        unsigned long period;
+        bool found = FALSE;
+        double result = 0.0;
+        FILE *f;
+
+        f = fopen ("/proc/self/cgroup", "r");
+        if (NULL == f)
+                return result;
+        /* On hybrid systems the v1 hierarchies are listed too. */
+        while (not found and NULL != fgets (line, sizeof (line), f))
+                found = (1 == sscanf (line, "0::%255s", cgroup));
+        fclose (f);
+        if (not found)
+                return result;
+
+        for (;;) {
+                snprintf (path, sizeof (path),
+                          "/sys/fs/cgroup%s/cpu.max",
+                          (0 == strcmp (cgroup, "/")) ? "" : cgroup);
+                f = fopen (path, "r");
+                if (NULL != f) {
+                        if (2 == fscanf (f, "%31s %lu", quota, &period)
+                            and 0 != strcmp (quota, "max")
+                            and period > 0) {
+                                double cpus = strtod (quota, NULL) / (double)period;
+                                if (cpus > 0.0 and (0.0 == result or cpus < result))
+                                        result = cpus;
+                        }
+                        fclose (f);
+                }
+                char *slash = strrchr (cgroup, '/');
+                if (NULL == slash or slash == cgroup)
+                        break;
+                *slash = '\0';
+        }
+        return result;
+}
+
+size_t GC_hugePageSize (void) {
+        static size_t hugePageSize = 1;
+        unsigned long size;
+        FILE *f;
+
+        if (1 != hugePageSize)
+                return hugePageSize;
+
+        hugePageSize = 0;
+        f = fopen ("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", "r");
+        if (NULL == f)
+                return hugePageSize;
+        if (1 == fscanf (f, "%lu", &size))
+                hugePageSize = (size_t)size;
+        fclose (f);
+        return hugePageSize;
+}
+
+void *GC_mmapAnonHuge (void *start, size_t length) {
+#ifdef MAP_HUGETLB
+        return GC_mmapAnonFlags (start, length, MAP_HUGETLB);
+#else
+        (void)start;
+        (void)length;
+        return MAP_FAILED;
+#endif
+}
+
+void GC_adviseHugePages (void *start, size_t length) {
+#ifdef MADV_HUGEPAGE
+        /* Failure is harmless: we just get small pages. */
+        madvise (start, length, MADV_HUGEPAGE);
+#else
+        (void)start;
+        (void)length;
+#endif
+}
+
+uintmax_t GC_hugePageResidentBytes (void) {
+        char line[128];
+        uintmax_t total = 0;
+        uintmax_t kb;
+        FILE *f;
+
+        f = fopen ("/proc/self/smaps_rollup", "r");
+        if (NULL == f)
+                return 0;
+        while (NULL != fgets (line, sizeof (line), f)) {
+                if (1 == sscanf (line, "AnonHugePages: %"SCNuMAX" kB", &kb)
+                    or 1 == sscanf (line, "Shared_Hugetlb: %"SCNuMAX" kB", &kb)
+                    or 1 == sscanf (line, "Private_Hugetlb: %"SCNuMAX" kB", &kb))
+                        total += kb * 1024;
+        }
+        fclose (f);
+        return total;
+}
@@ -4,6 +4,8 @@
 
 #include "platform/windows.c"
 #include "platform/mremap.c"
+#include "platform/hugepage.none.c"
+#include "platform/numa.none.c"
 
 void *GC_mmapAnon (void *start, size_t length) {
         return Windows_mmapAnon (start, length);
@@ -17,6 +19,10 @@ void GC_release (void *base, size_t length) {
         Windows_release (base, length);
 }
 
+bool GC_decommit (void *base, size_t length) {
+        return NULL != VirtualAlloc (base, length, MEM_RESET, PAGE_READWRITE);
+}
+
 void *GC_extendHead (void *base, size_t length) {
         return Windows_mmapAnon (base, length);
 }
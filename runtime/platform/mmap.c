@@ -18,3 +18,13 @@ static void munmap_safe (void *base, size_t length) {
         if (0 != munmap (base, length))
                 diee ("munmap failed");
 }
+
+bool GC_decommit (void *base, size_t length) {
+#ifdef MADV_DONTNEED
+        return 0 == madvise (base, length, MADV_DONTNEED);
+#else
+        (void)base;
+        (void)length;
+        return FALSE;
+#endif
+}
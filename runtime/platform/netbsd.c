@@ -4,5 +4,7 @@
 #include "platform/displayMem.proc.c"
 #include "platform/mmap-protect.c"
 #include "platform/nonwin.c"
+#include "platform/hugepage.none.c"
+#include "platform/numa.none.c"
 #include "platform/sysctl.c"
 #include "platform/use-mmap.c"
@@ -0,0 +1,32 @@
+uint32_t GC_numaNumNodes (void) {
+  return 1;
+}
+
+uint32_t GC_numaNodeOfCPU (__attribute__ ((unused)) uint32_t cpu) {
+  return 0;
+}
+
+uint32_t GC_numaNodeOfAddress (__attribute__ ((unused)) void *p) {
+  return 0;
+}
+
+void GC_numaBind (__attribute__ ((unused)) void *start,
+                  __attribute__ ((unused)) size_t length,
+                  __attribute__ ((unused)) uint32_t node) {
+}
+
+uint32_t GC_cpuCount (void) {
+  return 0;
+}
+
+uint32_t GC_cpuPackage (__attribute__ ((unused)) uint32_t cpu) {
+  return 0;
+}
+
+uint32_t GC_cpuCacheGroup (uint32_t cpu) {
+  return cpu;
+}
+
+double GC_cpuQuota (void) {
+  return 0.0;
+}
@@ -3,6 +3,8 @@
 #include "platform/diskBack.unix.c"
 #include "platform/mmap-protect.c"
 #include "platform/nonwin.c"
+#include "platform/hugepage.none.c"
+#include "platform/numa.none.c"
 #include "platform/sysconf.c"
 #include "platform/setenv.putenv.c"
 #include "platform/use-mmap.c"
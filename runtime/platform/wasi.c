@@ -1,5 +1,8 @@
 #include "platform.h"
 
+#include "platform/hugepage.none.c"
+#include "platform/numa.none.c"
+
 /* WASI only implements a subset of POSIX, and given how it works it doesn't
  * make too much sense to try too hard to emulate missing functionality.
  *
@@ -43,6 +46,11 @@ void GC_release (void *base, __attribute__ ((unused)) size_t length) {
         free (base);
 }
 
+bool GC_decommit (__attribute__ ((unused)) void *base,
+                  __attribute__ ((unused)) size_t length) {
+        return FALSE;
+}
+
 void GC_displayMem (void) {
         size_t memory_size = (size_t) sbrk(0);
         size_t pages = memory_size / PAGESIZE;
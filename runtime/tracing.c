@@ -7,25 +7,104 @@
 #include <sys/time.h>
 
 #include <assert.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
 
 #include "tracing.h"
 
+/* The writer thread. It sleeps until some context hands over a buffer, or
+ * for at most TRACING_WRITER_PERIOD_NS, since the hand-over signal is sent
+ * without holding the lock and may be missed. */
+#define TRACING_WRITER_PERIOD_NS 10000000L
+
+static pthread_once_t tracingWriterOnce = PTHREAD_ONCE_INIT;
+static pthread_mutex_t tracingWriterLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t tracingWriterCond = PTHREAD_COND_INITIALIZER;
+static struct TracingContext *tracingContexts = NULL;
+
+static inline void TracingRecord(struct TracingContext *ctx, int kind,
+                                 EventInt arg1, EventInt arg2, EventInt arg3);
+
+static void TracingWriteOut(struct TracingContext *ctx,
+                            struct Event *buffer,
+                            size_t nitems) {
+  if (fwrite(buffer, sizeof *buffer, nitems, ctx->file) < nitems) {
+    fprintf(stderr, "Tracing: could not write to file\n");
+    exit(1);
+  }
+}
+
+/* Write out the pending buffers of ctx, returning whether there were any.
+ * Requires tracingWriterLock. */
+static bool TracingDrainPending(struct TracingContext *ctx) {
+  bool wrote = false;
+  /* At most one buffer is pending at a time; see TracingSwitchBuffers. */
+  for (int i = 0; i < 2; i++) {
+    if (__atomic_load_n(&ctx->pending[i], __ATOMIC_ACQUIRE)) {
+      TracingWriteOut(ctx, ctx->buffers[i], ctx->capacity);
+      __atomic_store_n(&ctx->pending[i], 0, __ATOMIC_RELEASE);
+      wrote = true;
+    }
+  }
+  return wrote;
+}
+
+static void *TracingWriterLoop(__attribute__((unused)) void *arg) {
+  pthread_mutex_lock(&tracingWriterLock);
+  while (1) {
+    bool wrote = false;
+    for (struct TracingContext *ctx = tracingContexts;
+         ctx != NULL;
+         ctx = ctx->next)
+      wrote = TracingDrainPending(ctx) || wrote;
+
+    /* More buffers may have been handed over while we were writing. */
+    if (wrote)
+      continue;
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_nsec += TRACING_WRITER_PERIOD_NS;
+    if (deadline.tv_nsec >= 1000000000L) {
+      deadline.tv_sec++;
+      deadline.tv_nsec -= 1000000000L;
+    }
+    pthread_cond_timedwait(&tracingWriterCond, &tracingWriterLock, &deadline);
+  }
+  return NULL;
+}
+
+static void TracingStartWriter(void) {
+  pthread_t thread;
+  if (pthread_create(&thread, NULL, TracingWriterLoop, NULL) != 0) {
+    fprintf(stderr, "Tracing: could not start writer thread\n");
+    exit(1);
+  }
+  pthread_detach(thread);
+}
+
 struct TracingContext *TracingNewContext(const char *filename,
                                          size_t bufferCapacity,
                                          uint32_t procNumber) {
   struct TracingContext *ctx;
 
+  /* Room for at least an EVENT_TRACE_DROPPED and one more event. */
+  if (bufferCapacity < 2)
+    bufferCapacity = 2;
+
   if ((ctx = malloc(sizeof *ctx)) == NULL) {
     fprintf(stderr, "Tracing: could not allocate context\n");
     exit(1);
   }
 
-  if ((ctx->buffer = calloc(bufferCapacity, sizeof *ctx->buffer)) == NULL) {
-    fprintf(stderr, "Tracing: could not allocate buffer\n");
-    exit(1);
+  for (int i = 0; i < 2; i++) {
+    if ((ctx->buffers[i] = calloc(bufferCapacity, sizeof *ctx->buffers[i])) == NULL) {
+      fprintf(stderr, "Tracing: could not allocate buffer\n");
+      exit(1);
+    }
+    ctx->pending[i] = 0;
   }
 
   if ((ctx->file = fopen(filename, "wb")) == NULL) {
@@ -35,7 +114,15 @@ struct TracingContext *TracingNewContext(const char *filename,
 
   ctx->id = procNumber;
   ctx->capacity = bufferCapacity;
+  ctx->active = 0;
   ctx->index = 0;
+  ctx->dropped = 0;
+
+  pthread_once(&tracingWriterOnce, TracingStartWriter);
+  pthread_mutex_lock(&tracingWriterLock);
+  ctx->next = tracingContexts;
+  tracingContexts = ctx;
+  pthread_mutex_unlock(&tracingWriterLock);
 
   Trace_(ctx, EVENT_INIT, 0, 0, 0);
 
@@ -46,13 +133,30 @@ void TracingCloseAndFreeContext(struct TracingContext **ctx) {
   if (*ctx == NULL)
     return;
 
+  /* Make room for the final events, which must not be dropped. */
+  TracingFlushBuffer(*ctx);
+  if ((*ctx)->dropped > 0) {
+    TracingRecord(*ctx, EVENT_TRACE_DROPPED, (*ctx)->dropped, 0, 0);
+    (*ctx)->dropped = 0;
+  }
+
   /* Mark termination in the log file. */
-  Trace_(*ctx, EVENT_FINISH, 0, 0, 0);
+  TracingRecord(*ctx, EVENT_FINISH, 0, 0, 0);
 
   TracingFlushBuffer(*ctx);
 
+  pthread_mutex_lock(&tracingWriterLock);
+  for (struct TracingContext **p = &tracingContexts; *p != NULL; p = &(*p)->next) {
+    if (*p == *ctx) {
+      *p = (*ctx)->next;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&tracingWriterLock);
+
   fclose((*ctx)->file);
-  free((*ctx)->buffer);
+  free((*ctx)->buffers[0]);
+  free((*ctx)->buffers[1]);
   free(*ctx);
   *ctx = NULL;
 }
@@ -62,12 +166,11 @@ void TracingFlushBuffer(struct TracingContext *ctx) {
   assert(ctx->file);
   assert(ctx->index <= ctx->capacity);
 
-  size_t nitems = ctx->index;
-
-  if (fwrite(ctx->buffer, sizeof *ctx->buffer, nitems, ctx->file) < nitems) {
-    fprintf(stderr, "Tracing: could not write to file\n");
-    exit(1);
-  }
+  /* The pending buffer is older than the active one, so goes first. */
+  pthread_mutex_lock(&tracingWriterLock);
+  TracingDrainPending(ctx);
+  TracingWriteOut(ctx, ctx->buffers[ctx->active], ctx->index);
+  pthread_mutex_unlock(&tracingWriterLock);
 
   ctx->index = 0;
 }
@@ -88,22 +191,56 @@ TracingGetTimespec(struct timespec *ts)
 #endif
 }
 
+/* Hand the (full) active buffer over to the writer and continue in the
+ * other one, unless the writer is still busy with the other one. Returns
+ * whether we switched. */
+static bool TracingSwitchBuffers(struct TracingContext *ctx) {
+  int other = 1 - ctx->active;
+
+  if (__atomic_load_n(&ctx->pending[other], __ATOMIC_ACQUIRE))
+    return false;
+
+  __atomic_store_n(&ctx->pending[ctx->active], 1, __ATOMIC_RELEASE);
+  pthread_cond_signal(&tracingWriterCond);
+
+  ctx->active = other;
+  ctx->index = 0;
+  return true;
+}
+
+static inline void TracingRecord(struct TracingContext *ctx, int kind,
+                                 EventInt arg1, EventInt arg2, EventInt arg3) {
+  assert(ctx->index < ctx->capacity);
+
+  struct Event *ev = &ctx->buffers[ctx->active][ctx->index++];
+  ev->kind = kind;
+  ev->argptr = ctx->id;
+  TracingGetTimespec(&ev->ts);
+  ev->arg1 = arg1;
+  ev->arg2 = arg2;
+  ev->arg3 = arg3;
+}
+
 void Trace_(struct TracingContext *ctx, int kind,
             EventInt arg1, EventInt arg2, EventInt arg3) {
   if (!ctx)
     return;
 
-  assert(ctx->index < ctx->capacity);
+  /* The active buffer is still full from last time: the writer has fallen
+   * behind. */
+  if (ctx->index == ctx->capacity) {
+    if (!TracingSwitchBuffers(ctx)) {
+      ctx->dropped++;
+      return;
+    }
+    if (ctx->dropped > 0) {
+      TracingRecord(ctx, EVENT_TRACE_DROPPED, ctx->dropped, 0, 0);
+      ctx->dropped = 0;
+    }
+  }
 
-  struct Event ev;
-  ev.kind = kind;
-  ev.argptr = ctx->id;
-  TracingGetTimespec(&ev.ts);
-  ev.arg1 = arg1;
-  ev.arg2 = arg2;
-  ev.arg3 = arg3;
+  TracingRecord(ctx, kind, arg1, arg2, arg3);
 
-  ctx->buffer[ctx->index++] = ev;
   if (ctx->index == ctx->capacity)
-    TracingFlushBuffer(ctx);
+    TracingSwitchBuffers(ctx);
 }
@@ -12,14 +12,26 @@
 #include "trace.h"
 
 /* A structure holding the information required to record tracing
- * messages. Messages are buffered into memory and periodically flushed to disk
- * when the buffer is full. */
+ * messages. Messages are buffered into memory, in one of two buffers. When
+ * the current buffer is full, it is handed to a writer thread that flushes it
+ * to disk in the background, and recording continues in the other buffer. If
+ * the writer has not caught up by the time the other buffer is also full,
+ * further events are dropped, and an EVENT_TRACE_DROPPED event records how
+ * many. */
 struct TracingContext {
-  struct Event *buffer;
+  struct Event *buffers[2];
+  /* Set by the recording thread when it hands the buffer over to the writer,
+   * cleared by the writer when it has written it out. */
+  volatile int pending[2];
+  /* Index of the buffer currently being recorded into. */
+  int active;
   size_t id;
   size_t index;
   size_t capacity;
+  size_t dropped;
   FILE *file;
+  /* All live contexts are in a list, which the writer thread scans. */
+  struct TracingContext *next;
 };
 
 /* Allocates a new tracing context and open its backing file. */
@@ -31,9 +43,9 @@ struct TracingContext *TracingNewContext(const char *filename,
  * flushed. */
 void TracingCloseAndFreeContext(struct TracingContext **ctx);
 
-/* Flush recent events to the backing file. This function is automatically
- * called by Trace() when the trace buffer is full, so there should be no need
- * to call it manually. */
+/* Synchronously flush recent events to the backing file. Buffers are
+ * flushed automatically in the background, so there should be no need to call
+ * this manually. Must be called by the thread that records into ctx. */
 void TracingFlushBuffer(struct TracingContext *ctx);
 
 /* Add a new log event to the tracing context. */